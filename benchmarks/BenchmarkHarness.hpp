@@ -0,0 +1,193 @@
+#pragma once // Avoid multiple inclusion
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Keep a value alive without letting the compiler see how it is used
+template <typename T>
+inline void doNotOptimize(const T& value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Minimal offline micro-benchmark harness (header only, no dependency).
+// An operation is called in batches until a minimum time has elapsed; this is repeated a few
+// times and the median time per operation is reported, with the fastest and slowest repetitions
+// as the spread. Results are printed as a table and, with --json <file>, written as JSON so that
+// two commits can be compared. Command line:
+//   --json <file>        Write the results as JSON
+//   --filter <text>      Only run the benchmarks whose name contains the text
+//   --min-time <ms>      Minimum time per repetition (default 100)
+//   --repetitions <n>    Repetitions per benchmark (default 5)
+//   --label <text>       Free label stored in the JSON context (commit, machine...)
+class BenchmarkHarness
+{
+    public:
+        // Result of one benchmark
+        struct Result
+        {
+            std::string name;                   // Benchmark name (group/case/parameter)
+            std::size_t iterations = 0;         // Operations timed over all repetitions
+            double median_ns = 0.0;             // Median time per operation
+            double min_ns = 0.0;                // Fastest repetition
+            double max_ns = 0.0;                // Slowest repetition
+        };
+
+        // Constructor: parse the command line (exits on a usage error)
+        BenchmarkHarness(int argc, char** argv)
+        {
+            for (int i = 1; i < argc; i++)
+            {
+                const std::string option = argv[i];
+                if (i + 1 >= argc)
+                    usage(argv[0]);
+                const std::string value = argv[++i];
+                if (option == "--json")
+                    json_path_ = value;
+                else if (option == "--filter")
+                    filter_ = value;
+                else if (option == "--min-time")
+                    min_time_ = std::chrono::milliseconds(std::atol(value.c_str()));
+                else if (option == "--repetitions")
+                    repetitions_ = std::max(1, std::atoi(value.c_str()));
+                else if (option == "--label")
+                    label_ = value;
+                else
+                    usage(argv[0]);
+            }
+            std::printf("%-48s %14s %12s %12s %12s\n", "benchmark", "iterations", "median ns", "min ns", "max ns");
+        }
+
+        // Check if a benchmark is selected by the filter
+        bool selected(const std::string& name) const { return name.find(filter_) != std::string::npos; }
+
+        // Time an operation; setup runs untimed before every repetition
+        template <typename Operation, typename Setup>
+        void run(const std::string& name, Operation&& operation, Setup&& setup)
+        {
+            using namespace std::chrono;
+            if (!selected(name))
+                return;
+
+            // Batch size: enough calls per clock reading to hide the clock overhead (about 10 us)
+            setup();
+            std::size_t batch = 1;
+            for (;;)
+            {
+                const auto start = steady_clock::now();
+                for (std::size_t i = 0; i < batch; i++)
+                    operation();
+                if (steady_clock::now() - start >= microseconds(10) || batch >= (std::size_t(1) << 24))
+                    break;
+                batch *= 2;
+            }
+
+            Result result;
+            result.name = name;
+            std::vector<double> samples;
+            for (int repetition = 0; repetition < repetitions_; repetition++)
+            {
+                setup();
+                std::size_t iterations = 0;
+                const auto start = steady_clock::now();
+                auto elapsed = steady_clock::duration::zero();
+                do
+                {
+                    for (std::size_t i = 0; i < batch; i++)
+                        operation();
+                    iterations += batch;
+                    elapsed = steady_clock::now() - start;
+                } while (elapsed < min_time_);
+                samples.push_back(static_cast<double>(duration_cast<nanoseconds>(elapsed).count()) / static_cast<double>(iterations));
+                result.iterations += iterations;
+            }
+
+            std::sort(samples.begin(), samples.end());
+            result.median_ns = samples[samples.size() / 2];
+            result.min_ns = samples.front();
+            result.max_ns = samples.back();
+            std::printf("%-48s %14zu %12.1f %12.1f %12.1f\n",
+                name.c_str(), result.iterations, result.median_ns, result.min_ns, result.max_ns);
+            std::fflush(stdout);
+            results_.push_back(result);
+        }
+
+        // Time an operation without setup
+        template <typename Operation>
+        void run(const std::string& name, Operation&& operation)
+        {
+            run(name, std::forward<Operation>(operation), [] {});
+        }
+
+        // Write the JSON output, if requested; returns the process exit code
+        int finish() const
+        {
+            if (json_path_.empty())
+                return 0;
+
+            std::ofstream file(json_path_);
+            if (!file)
+            {
+                std::fprintf(stderr, "Cannot write %s\n", json_path_.c_str());
+                return 1;
+            }
+
+            char date[32];
+            const std::time_t now = std::time(nullptr);
+            std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+            file << "{\n  \"context\": {\n"
+                 << "    \"date\": \"" << date << "\",\n"
+                 << "    \"label\": \"" << escape(label_) << "\",\n"
+                 << "    \"compiler\": \"" << escape(__VERSION__) << "\",\n"
+                 << "    \"hardware_threads\": " << std::thread::hardware_concurrency() << ",\n"
+                 << "    \"min_time_ms\": " << min_time_.count() << ",\n"
+                 << "    \"repetitions\": " << repetitions_ << "\n  },\n"
+                 << "  \"benchmarks\": [";
+            for (std::size_t i = 0; i < results_.size(); i++)
+            {
+                const Result& result = results_[i];
+                file << (i == 0 ? "\n" : ",\n")
+                     << "    {\"name\": \"" << escape(result.name) << "\", \"iterations\": " << result.iterations
+                     << ", \"median_ns\": " << result.median_ns << ", \"min_ns\": " << result.min_ns
+                     << ", \"max_ns\": " << result.max_ns << "}";
+            }
+            file << "\n  ]\n}\n";
+            std::printf("Results written to %s\n", json_path_.c_str());
+            return 0;
+        }
+
+    private:
+        [[noreturn]] static void usage(const char* program)
+        {
+            std::fprintf(stderr, "Usage: %s [--json <file>] [--filter <text>] [--min-time <ms>] [--repetitions <n>] [--label <text>]\n", program);
+            std::exit(2);
+        }
+
+        // Escape a JSON string
+        static std::string escape(const std::string& text)
+        {
+            std::string escaped;
+            for (char character : text)
+            {
+                if (character == '"' || character == '\\')
+                    escaped += '\\';
+                if (static_cast<unsigned char>(character) >= 0x20)
+                    escaped += character;
+            }
+            return escaped;
+        }
+
+        std::string json_path_;                                 // JSON output ("" = none)
+        std::string filter_;                                    // Name filter
+        std::string label_;                                     // Free label of the run
+        std::chrono::milliseconds min_time_{100};               // Minimum time per repetition
+        int repetitions_ = 5;                                   // Repetitions per benchmark
+        std::vector<Result> results_;                           // Completed benchmarks
+};
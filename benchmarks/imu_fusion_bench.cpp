@@ -0,0 +1,107 @@
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <optional>
+#include <random>
+#include <vector>
+#include "ImuSnapshot.hpp"
+
+// Micro-benchmark of the IMU fusion reduction: the former ProcessingUnit path
+// (vector of optional triplets passed by value) against the ImuSnapshot kernels
+
+namespace
+{
+    using LegacyImuData = std::vector<std::array<std::optional<double>, 3>>;
+
+    // Former path: input copied on every call, one optional check per value (first-sample bug fixed)
+    std::array<std::optional<double>, 3> legacyMean(LegacyImuData imu_data)
+    {
+        std::array<std::optional<double>, 3> sum = {std::nullopt, std::nullopt, std::nullopt};
+        int valid_imu_count = 0;
+        for (const auto& imu : imu_data)
+        {
+            if (imu[0] != std::nullopt && imu[1] != std::nullopt && imu[2] != std::nullopt)
+            {
+                valid_imu_count++;
+                for (std::size_t axis = 0; axis < 3; axis++)
+                    sum[axis] = sum[axis].value_or(0.0) + imu[axis].value();
+            }
+        }
+        std::array<std::optional<double>, 3> mean = {std::nullopt, std::nullopt, std::nullopt};
+        if (valid_imu_count > 0)
+        {
+            for (std::size_t axis = 0; axis < 3; axis++)
+                mean[axis] = sum[axis].value() / valid_imu_count;
+        }
+        return mean;
+    }
+
+    // Average time per call in ns (repeated until at least 200 ms have elapsed)
+    double measure(const std::function<double()>& call)
+    {
+        using namespace std::chrono;
+        volatile double sink = 0.0;
+        std::size_t iterations = 0;
+        const auto start = steady_clock::now();
+        auto elapsed = steady_clock::duration::zero();
+        do
+        {
+            for (int i = 0; i < 1000; i++)
+                sink = sink + call();
+            iterations += 1000;
+            elapsed = steady_clock::now() - start;
+        } while (elapsed < milliseconds(200));
+        return static_cast<double>(duration_cast<nanoseconds>(elapsed).count()) / static_cast<double>(iterations);
+    }
+}
+
+int main()
+{
+    std::mt19937_64 generator(42);
+    std::normal_distribution<double> noise(1.0, 0.01);
+    std::bernoulli_distribution faulty(0.1);
+
+    const char* level_names[] = {"scalar", "sse2", "avx2"};
+    std::printf("Best instruction set: %s\n\n", level_names[static_cast<int>(detectSimdLevel())]);
+    std::printf("%8s %12s %12s %12s %12s %12s %10s\n",
+        "imus", "legacy ns", "scalar ns", "sse2 ns", "avx2 ns", "avx2+var ns", "speedup");
+
+    for (std::size_t imu_count : {3, 16, 64, 256, 1024})
+    {
+        // Same data in both layouts, 10% of the channels invalid
+        LegacyImuData legacy(imu_count);
+        ImuSnapshot snapshot;
+        snapshot.resize(imu_count);
+        for (std::size_t i = 0; i < imu_count; i++)
+        {
+            if (faulty(generator))
+                continue;
+            const double x = noise(generator), y = noise(generator), z = noise(generator);
+            legacy[i] = {x, y, z};
+            snapshot.set(i, x, y, z);
+        }
+
+        // Results must agree
+        const auto expected = legacyMean(legacy);
+        for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::Sse2, SimdLevel::Avx2})
+        {
+            const ImuStatistics statistics = fuseImuSnapshot(snapshot, true, level);
+            if (expected[0] && std::abs(statistics.mean[0] - *expected[0]) > 1e-9)
+            {
+                std::fprintf(stderr, "Mismatch with %s kernel for %zu IMUs\n", level_names[static_cast<int>(level)], imu_count);
+                return 1;
+            }
+        }
+
+        const double legacy_ns = measure([&] { return legacyMean(legacy)[0].value_or(0.0); });
+        const double scalar_ns = measure([&] { return fuseImuSnapshot(snapshot, false, SimdLevel::Scalar).mean[0]; });
+        const double sse2_ns = measure([&] { return fuseImuSnapshot(snapshot, false, SimdLevel::Sse2).mean[0]; });
+        const double avx2_ns = measure([&] { return fuseImuSnapshot(snapshot, false, SimdLevel::Avx2).mean[0]; });
+        const double variance_ns = measure([&] { return fuseImuSnapshot(snapshot, true, SimdLevel::Avx2).variance[0]; });
+        std::printf("%8zu %12.1f %12.1f %12.1f %12.1f %12.1f %9.1fx\n",
+            imu_count, legacy_ns, scalar_ns, sse2_ns, avx2_ns, variance_ns, legacy_ns / avx2_ns);
+    }
+    return 0;
+}
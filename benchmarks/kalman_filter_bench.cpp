@@ -0,0 +1,67 @@
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include "NavigationFilter.hpp"
+
+// Micro-benchmark of the navigation filter steps: predict (IMU rate) and update (GNSS rate)
+
+namespace
+{
+    // Average time per call in ns (repeated until at least 200 ms have elapsed)
+    double measure(const std::function<double()>& call)
+    {
+        using namespace std::chrono;
+        volatile double sink = 0.0;
+        std::size_t iterations = 0;
+        const auto start = steady_clock::now();
+        auto elapsed = steady_clock::duration::zero();
+        do
+        {
+            for (int i = 0; i < 1000; i++)
+                sink = sink + call();
+            iterations += 1000;
+            elapsed = steady_clock::now() - start;
+        } while (elapsed < milliseconds(200));
+        return static_cast<double>(duration_cast<nanoseconds>(elapsed).count()) / static_cast<double>(iterations);
+    }
+}
+
+int main()
+{
+    std::mt19937_64 generator(42);
+    std::normal_distribution<double> rate_noise(0.0, 0.01);
+    std::normal_distribution<double> position_noise(0.0, 0.01);
+
+    // Same profile as the simulation: 100 Hz IMUs, 20 Hz GNSS around 1.0 on every axis
+    const double imu_dt = 0.01;
+    const std::size_t imu_per_gnss = 5;
+
+    // Sanity check: 60 s of simulated data must converge on the true position
+    NavigationFilter filter;
+    filter.initialize({1.0, 1.0, 1.0}, 0.01);
+    for (std::size_t step = 0; step < 6000; step++)
+    {
+        filter.predict({1.0 + rate_noise(generator), 1.0 + rate_noise(generator), 1.0 + rate_noise(generator)}, imu_dt, 0.01);
+        if (step % imu_per_gnss == imu_per_gnss - 1)
+            filter.update({1.0 + position_noise(generator), 1.0 + position_noise(generator), 1.0 + position_noise(generator)}, 0.01);
+    }
+    const double error = std::abs(filter.position()[0] - 1.0);
+    if (error > 0.05)
+    {
+        std::fprintf(stderr, "Filter diverged: position error %.3f\n", error);
+        return 1;
+    }
+
+    const std::array<double, 3> rate = {1.0, 1.0, 1.0};
+    const std::array<double, 3> position = {1.0, 1.0, 1.0};
+    const double predict_ns = measure([&] { filter.predict(rate, imu_dt, 0.01); return filter.position()[0]; });
+    const double update_ns = measure([&] { filter.update(position, 0.01); return filter.position()[0]; });
+
+    std::printf("%zu-state error-state filter, position error after 60 s: %.4f\n\n", NavigationFilter::states, error);
+    std::printf("%12s %12s %18s\n", "predict ns", "update ns", "ns per GNSS epoch");
+    std::printf("%12.1f %12.1f %18.1f\n", predict_ns, update_ns, imu_per_gnss * predict_ns + update_ns);
+    return 0;
+}
@@ -0,0 +1,190 @@
+#include <atomic>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "BenchmarkHarness.hpp"
+#include "ImuSensor.hpp"
+#include "GnssSensor.hpp"
+#include "ProcessingUnit.hpp"
+#include "Fdir.hpp"
+#include "Logger.hpp"
+
+// Micro-benchmarks of the simulation hot paths: sensor publish/read, ProcessingUnit fusion,
+// FDIR cycle and logging. The components are driven through a manual executor, so every
+// benchmark calls the same tick the threads or the reactor would, without any scheduling.
+// Usage: sensors-bench [--json <file>] [--filter <text>] [--min-time <ms>] [--repetitions <n>] [--label <text>]
+
+namespace
+{
+    // Executor that only keeps the tasks: the benchmark calls their ticks directly
+    class ManualExecutor : public Executor
+    {
+        public:
+            TaskId add(PeriodicTask task) override
+            {
+                tasks_.push_back(std::move(task));
+                return tasks_.size();
+            }
+
+            void remove(TaskId) override {}
+
+            // Tick of a scheduled task
+            const std::function<void()>& tick(TaskId id) const { return tasks_[id - 1].tick; }
+
+        private:
+            std::vector<PeriodicTask> tasks_;
+    };
+
+    // Sensors started on a manual executor, with their ticks
+    template <typename SensorT>
+    struct SensorSet
+    {
+        std::shared_ptr<ManualExecutor> executor = std::make_shared<ManualExecutor>();
+        std::vector<std::shared_ptr<SensorT>> sensors;
+
+        SensorSet(const std::string& prefix, std::size_t count, double frequency)
+        {
+            for (std::size_t i = 0; i < count; i++)
+            {
+                sensors.push_back(std::make_shared<SensorT>(prefix + std::to_string(i), frequency, 0.01));
+                sensors.back()->setSeed(42);
+                sensors.back()->setExecutor(executor);
+                sensors.back()->start();
+            }
+        }
+
+        ~SensorSet()
+        {
+            for (auto& sensor : sensors)
+                sensor->stop();
+        }
+
+        // Publish one sample on every sensor
+        void publish(std::size_t samples = 1) const
+        {
+            for (std::size_t k = 0; k < samples; k++)
+                for (std::size_t i = 0; i < sensors.size(); i++)
+                    executor->tick(i + 1)();
+        }
+    };
+
+    // Sensor publish and read paths
+    void benchmarkSensors(BenchmarkHarness& harness)
+    {
+        SensorSet<ImuSensor> imus("imu", 1, 100.0);
+        const auto& tick = imus.executor->tick(1);
+        const ImuSensor& imu = *imus.sensors[0];
+
+        // Generate, push to the ring buffer, publish the SeqLock snapshot and the heartbeat
+        harness.run("sensor/publish", [&] { tick(); });
+
+        // Lock-free reads of the latest sample and of one buffered sample
+        harness.run("sensor/read_latest", [&] { doNotOptimize(imu.getLatest()); });
+        harness.run("sensor/read_sample", [&] {
+            Sensor::Sample sample;
+            doNotOptimize(imu.readSample(imu.getSampleHead() - 1, sample));
+        });
+
+        // Reads while another thread publishes as fast as it can (SeqLock retries, cache line transfers)
+        std::atomic<bool> publishing{true};
+        std::thread publisher([&] { while (publishing.load(std::memory_order_relaxed)) tick(); });
+        harness.run("sensor/read_latest_contended", [&] { doNotOptimize(imu.getLatest()); });
+        publishing = false;
+        publisher.join();
+    }
+
+    // ProcessingUnit fusion of the default suite (3 IMUs, 2 GNSS)
+    void benchmarkProcessing(BenchmarkHarness& harness)
+    {
+        SensorSet<ImuSensor> imus("imu", 3, 100.0);
+        SensorSet<GnssSensor> gnss("gnss", 2, 20.0);
+        ProcessingUnit processing_unit(imus.sensors, gnss.sensors, 50.0);
+        ImuFusion imu_fusion(imus.sensors);
+
+        // Fresh samples before every repetition (the GNSS data must not be older than one second)
+        auto refresh = [&] { imus.publish(ImuFusion::window); gnss.publish(); };
+        harness.run("processing/get_sensor_data", [&] { doNotOptimize(processing_unit.getSensorData()); }, refresh);
+
+        // Attitude rate alone: time-aligned IMU fusion
+        harness.run("processing/fuse_imu", [&] { doNotOptimize(imu_fusion.fuse()); }, refresh);
+    }
+
+    // FDIR cycle at increasing sensor counts
+    void benchmarkFdir(BenchmarkHarness& harness, std::shared_ptr<ProcessingUnit> processing_unit)
+    {
+        for (std::size_t count : {10, 100, 1000})
+        {
+            const std::string suffix = "/" + std::to_string(count);
+            if (!harness.selected("fdir/tick" + suffix) && !harness.selected("fdir/tick_new_samples" + suffix))
+                continue;
+
+            // One redundant group; the nominal period (10 s) keeps the deadlines in the future,
+            // so that no sensor is reported failed while it is not ticked
+            SensorSet<ImuSensor> imus("imu", count, 0.1);
+            imus.publish();
+            auto executor = std::make_shared<ManualExecutor>();
+            Fdir fdir(processing_unit);
+            for (auto& imu : imus.sensors)
+                fdir.addSensor(imu, "imu");
+            fdir.setExecutor(executor);
+            fdir.start();
+            const auto& tick = executor->tick(1);
+
+            // Nothing new: deadline heap, sample cursors and processing unit check
+            harness.run("fdir/tick" + suffix, [&] { tick(); });
+
+            // One new sample per sensor: detectors and group vote (includes the sensor publish)
+            harness.run("fdir/tick_new_samples" + suffix, [&] { imus.publish(); tick(); });
+            fdir.stop();
+        }
+    }
+
+    // Logger throughput from the calling thread
+    void benchmarkLogger(BenchmarkHarness& harness, const Logger::Config& base_config)
+    {
+        const std::string message = "[Bench] Sensor imu1 sample 123456 published";
+
+        // Producer cost: the queue drops the messages the writer cannot keep up with
+        Logger::Config config = base_config;
+        config.overflow_policy = Logger::OverflowPolicy::Drop;
+        Logger::init(config);
+        harness.run("logger/log_drop", [&] { Logger::log(Logger::Level::Info, message); });
+
+        // Sustained throughput: the producer waits for the writer thread
+        config.overflow_policy = Logger::OverflowPolicy::Block;
+        Logger::init(config);
+        harness.run("logger/log_block", [&] { Logger::log(Logger::Level::Info, message); });
+
+        // Writing on the calling thread
+        config.asynchronous = false;
+        Logger::init(config);
+        harness.run("logger/log_sync", [&] { Logger::log(Logger::Level::Info, message); });
+    }
+}
+
+int main(int argc, char** argv)
+{
+    BenchmarkHarness harness(argc, argv);
+
+    // Component messages go to a temporary log directory, not to the console
+    Logger::Config config;
+    config.console = false;
+    config.directory = (std::filesystem::temp_directory_path() / "sensors-bench-log").string();
+    Logger::init(config);
+
+    benchmarkSensors(harness);
+    benchmarkProcessing(harness);
+    {
+        SensorSet<ImuSensor> no_imus("imu", 0, 100.0);
+        SensorSet<GnssSensor> no_gnss("gnss", 0, 20.0);
+        benchmarkFdir(harness, std::make_shared<ProcessingUnit>(no_imus.sensors, no_gnss.sensors, 50.0));
+    }
+    benchmarkLogger(harness, config);
+
+    Logger::shutdown();
+    std::filesystem::remove_all(config.directory);
+    return harness.finish();
+}
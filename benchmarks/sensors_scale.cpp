@@ -0,0 +1,281 @@
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "ImuSensor.hpp"
+#include "GnssSensor.hpp"
+#include "SensorSuite.hpp"
+#include "ProcessingUnit.hpp"
+#include "Fdir.hpp"
+#include "Simulator.hpp"
+#include "Logger.hpp"
+#include "Reactor.hpp"
+#include "WorkerPool.hpp"
+
+// Scale test of the whole simulation: for a growing number of IMUs (one redundancy group, plus
+// two GNSS), build the suite in bulk, start it, let it run and report the startup time and the
+// steady-state CPU cost and heap allocation rate (none expected once running). Everything a run
+// writes (logs, recordings) goes to a temporary directory.
+// Usage: sensors-scale [--counts <n,n,...>] [--seconds <s>] [--frequency <Hz>]
+//                      [--mode thread|reactor|pool] [--json <file>]
+
+// Heap allocations of the process, counted by the replaced global allocation functions (every
+// form of operator new, including the aligned ones used by the cache-line aligned buffers, and
+// the matching deletes, so that no allocation goes around the count)
+static std::atomic<std::uint64_t> allocations{0};
+
+// Counted allocation (nullptr on failure)
+static void* allocate(std::size_t size, std::size_t alignment = 0) noexcept
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (size == 0)
+        size = 1;
+    if (alignment <= alignof(std::max_align_t))
+        return std::malloc(size);
+    return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+}
+
+// Counted allocation, throwing on failure
+static void* allocateOrThrow(std::size_t size, std::size_t alignment = 0)
+{
+    if (void* memory = allocate(size, alignment))
+        return memory;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size) { return allocateOrThrow(size); }
+void* operator new[](std::size_t size) { return allocateOrThrow(size); }
+void* operator new(std::size_t size, std::align_val_t alignment) { return allocateOrThrow(size, static_cast<std::size_t>(alignment)); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return allocateOrThrow(size, static_cast<std::size_t>(alignment)); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return allocate(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return allocate(size); }
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return allocate(size, static_cast<std::size_t>(alignment)); }
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return allocate(size, static_cast<std::size_t>(alignment)); }
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete(void* memory, std::align_val_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::align_val_t) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept { std::free(memory); }
+void operator delete(void* memory, const std::nothrow_t&) noexcept { std::free(memory); }
+void operator delete[](void* memory, const std::nothrow_t&) noexcept { std::free(memory); }
+void operator delete(void* memory, std::align_val_t, const std::nothrow_t&) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::align_val_t, const std::nothrow_t&) noexcept { std::free(memory); }
+
+namespace
+{
+    // Command line options
+    struct Options
+    {
+        std::vector<std::size_t> counts{8, 32, 128, 512};   // IMU counts
+        double seconds = 3.0;                               // Steady-state measurement time
+        double frequency = 100.0;                           // IMU frequency in Hz
+        std::string mode = "thread";                        // Execution mode
+        std::string json;                                   // JSON result file ("" = none)
+    };
+
+    // Result of one suite size
+    struct Result
+    {
+        std::size_t sensors = 0;        // Sensors in the suite
+        double build_ms = 0.0;          // Bulk construction of the sensors
+        double wire_ms = 0.0;           // ProcessingUnit, FDIR and simulator construction
+        double start_ms = 0.0;          // Simulator start
+        double stop_ms = 0.0;           // Simulator stop
+        double cpu_percent = 0.0;       // Process CPU time over wall time (100 = one core)
+        double ns_per_sample = 0.0;     // CPU time per produced sample
+        double rate_percent = 0.0;      // Produced samples over the nominal rate
+        double allocs_per_s = 0.0;      // Heap allocations per second in steady state
+    };
+
+    double elapsedMs(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // Process CPU time in ns (every thread)
+    double processCpuNs()
+    {
+        timespec time;
+        clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time);
+        return static_cast<double>(time.tv_sec) * 1e9 + static_cast<double>(time.tv_nsec);
+    }
+
+    // Samples produced so far by every sensor
+    template <typename SensorT>
+    std::uint64_t produced(const std::vector<std::shared_ptr<SensorT>>& sensors)
+    {
+        std::uint64_t count = 0;
+        for (const auto& sensor : sensors)
+            count += sensor->getMetrics().snapshot().produced;
+        return count;
+    }
+
+    bool parseOptions(int argc, char** argv, Options& options)
+    {
+        for (int i = 1; i < argc; i++)
+        {
+            const std::string option = argv[i];
+            if (i + 1 >= argc)
+                return false;
+            const std::string value = argv[++i];
+            if (option == "--counts")
+            {
+                options.counts.clear();
+                std::istringstream list(value);
+                std::string count;
+                while (std::getline(list, count, ','))
+                    options.counts.push_back(std::strtoull(count.c_str(), nullptr, 10));
+            }
+            else if (option == "--seconds")
+                options.seconds = std::atof(value.c_str());
+            else if (option == "--frequency")
+                options.frequency = std::atof(value.c_str());
+            else if (option == "--mode" && (value == "thread" || value == "reactor" || value == "pool"))
+                options.mode = value;
+            else if (option == "--json")
+                options.json = value;
+            else
+                return false;
+        }
+        return options.seconds > 0.0 && options.frequency > 0.0;
+    }
+
+    // Build, start, measure and stop one suite
+    Result runSuite(const Options& options, std::size_t imu_count)
+    {
+        const std::vector<SensorGroup> groups = {
+            {SensorKind::Imu, "imu", imu_count, options.frequency, 0.01},
+            {SensorKind::Gnss, "gnss", 2, 20.0, 0.01}
+        };
+        Result result;
+        result.sensors = imu_count + 2;
+
+        auto start = std::chrono::steady_clock::now();
+        auto imu_sensors = makeSensors<ImuSensor>(groups, SensorKind::Imu);
+        auto gnss_sensors = makeSensors<GnssSensor>(groups, SensorKind::Gnss);
+        result.build_ms = elapsedMs(start);
+
+        start = std::chrono::steady_clock::now();
+        std::shared_ptr<Reactor> reactor;
+        if (options.mode != "thread")
+        {
+            reactor = options.mode == "pool" ? std::make_shared<Reactor>(std::make_shared<WorkerPool>()) : std::make_shared<Reactor>();
+            reactor->start();
+        }
+        auto processing_unit = std::make_shared<ProcessingUnit>(imu_sensors, gnss_sensors, 50.0);
+        auto fdir = std::make_shared<Fdir>(processing_unit);
+        for (auto& imu_sensor : imu_sensors)
+            fdir->addSensor(imu_sensor, "imu");
+        for (auto& gnss_sensor : gnss_sensors)
+            fdir->addSensor(gnss_sensor, "gnss");
+        if (reactor)
+        {
+            for (auto& imu_sensor : imu_sensors)
+                imu_sensor->setExecutor(reactor);
+            for (auto& gnss_sensor : gnss_sensors)
+                gnss_sensor->setExecutor(reactor);
+            processing_unit->setExecutor(reactor);
+            fdir->setExecutor(reactor);
+        }
+        Simulator simulator(imu_sensors, gnss_sensors, processing_unit, fdir);
+        result.wire_ms = elapsedMs(start);
+
+        start = std::chrono::steady_clock::now();
+        simulator.start();
+        result.start_ms = elapsedMs(start);
+
+        // Steady state: skip the first half second, then measure
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        const double cpu_start = processCpuNs();
+        const std::uint64_t samples_start = produced(imu_sensors) + produced(gnss_sensors);
+        const std::uint64_t allocations_start = allocations.load(std::memory_order_relaxed);
+        start = std::chrono::steady_clock::now();
+        std::this_thread::sleep_for(std::chrono::duration<double>(options.seconds));
+        const double wall_ns = elapsedMs(start) * 1e6;
+        const double cpu_ns = processCpuNs() - cpu_start;
+        result.allocs_per_s = static_cast<double>(allocations.load(std::memory_order_relaxed) - allocations_start) * 1e9 / wall_ns;
+        const std::uint64_t samples = produced(imu_sensors) + produced(gnss_sensors) - samples_start;
+
+        result.cpu_percent = 100.0 * cpu_ns / wall_ns;
+        result.ns_per_sample = samples > 0 ? cpu_ns / static_cast<double>(samples) : 0.0;
+        const double nominal = (static_cast<double>(imu_count) * options.frequency + 2 * 20.0) * wall_ns / 1e9;
+        result.rate_percent = 100.0 * static_cast<double>(samples) / nominal;
+
+        start = std::chrono::steady_clock::now();
+        simulator.stop();
+        result.stop_ms = elapsedMs(start);
+        if (reactor)
+            reactor->stop();
+        return result;
+    }
+
+    void writeJson(const Options& options, const std::vector<Result>& results)
+    {
+        std::ofstream file(options.json);
+        file << "{\n  \"mode\": \"" << options.mode << "\",\n  \"frequency_hz\": " << options.frequency
+             << ",\n  \"seconds\": " << options.seconds << ",\n  \"results\": [\n";
+        for (std::size_t i = 0; i < results.size(); i++)
+        {
+            const Result& r = results[i];
+            file << "    {\"sensors\": " << r.sensors << ", \"build_ms\": " << r.build_ms << ", \"wire_ms\": " << r.wire_ms
+                 << ", \"start_ms\": " << r.start_ms << ", \"stop_ms\": " << r.stop_ms << ", \"cpu_percent\": " << r.cpu_percent
+                 << ", \"ns_per_sample\": " << r.ns_per_sample << ", \"rate_percent\": " << r.rate_percent
+                 << ", \"allocs_per_s\": " << r.allocs_per_s << "}"
+                 << (i + 1 < results.size() ? ",\n" : "\n");
+        }
+        file << "  ]\n}\n";
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Options options;
+    if (!parseOptions(argc, argv, options))
+    {
+        std::fprintf(stderr, "Usage: %s [--counts <n,n,...>] [--seconds <s>] [--frequency <Hz>] [--mode thread|reactor|pool] [--json <file>]\n", argv[0]);
+        return 1;
+    }
+    if (!options.json.empty())
+        options.json = std::filesystem::absolute(options.json).string();
+
+    // The components write to ../log and ../data: run from a temporary directory
+    const std::filesystem::path root = std::filesystem::temp_directory_path() / "sensors-scale";
+    const std::filesystem::path origin = std::filesystem::current_path();
+    std::filesystem::create_directories(root / "run");
+    std::filesystem::current_path(root / "run");
+    Logger::Config config;
+    config.console = false;
+    Logger::init(config);
+
+    std::printf("%8s %10s %10s %10s %10s %8s %12s %8s %10s\n", "sensors", "build ms", "wire ms", "start ms", "stop ms", "cpu %", "ns/sample", "rate %", "allocs/s");
+    std::vector<Result> results;
+    for (std::size_t count : options.counts)
+    {
+        const Result r = runSuite(options, count);
+        std::printf("%8zu %10.2f %10.2f %10.2f %10.2f %8.1f %12.0f %8.1f %10.1f\n",
+            r.sensors, r.build_ms, r.wire_ms, r.start_ms, r.stop_ms, r.cpu_percent, r.ns_per_sample, r.rate_percent, r.allocs_per_s);
+        std::fflush(stdout);
+        results.push_back(r);
+    }
+
+    Logger::shutdown();
+    std::filesystem::current_path(origin);
+    std::filesystem::remove_all(root);
+    if (!options.json.empty())
+        writeJson(options, results);
+    return 0;
+}
@@ -0,0 +1,143 @@
+#pragma once // Avoid multiple inclusion
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+// Streaming fault detectors fed one sample at a time (O(1) time and memory per sample, no windows).
+// Thresholds are expressed in units of the sensor noise standard deviation.
+
+// Detector thresholds
+struct DetectorConfig
+{
+    std::size_t stuck_samples = 10;     // Consecutive identical samples for a stuck sensor
+    std::size_t noise_block = 100;      // Samples per noise estimate
+    double noise_ratio = 3.0;           // Measured / nominal noise outside [1/ratio, ratio] is a drift
+    double cusum_drift = 1.0;           // CUSUM allowance k (noise units per sample)
+    double cusum_threshold = 10.0;      // CUSUM alarm level h (noise units)
+    double vote_threshold = 6.0;        // Distance from the group median for a disagreement (noise units)
+    std::size_t vote_samples = 5;       // Consecutive disagreements to isolate a unit
+};
+
+// Welford running mean and variance
+class RunningStats
+{
+    public:
+        // Add a value
+        void add(double value)
+        {
+            count_++;
+            const double delta = value - mean_;
+            mean_ += delta / static_cast<double>(count_);
+            m2_ += delta * (value - mean_);
+        }
+
+        // Clear the statistics
+        void reset() { count_ = 0; mean_ = 0.0; m2_ = 0.0; }
+
+        std::size_t count() const { return count_; }
+        double mean() const { return mean_; }
+        double variance() const { return count_ > 1 ? m2_ / static_cast<double>(count_ - 1) : 0.0; }
+
+    private:
+        std::size_t count_ = 0;     // Values added
+        double mean_ = 0.0;         // Running mean
+        double m2_ = 0.0;           // Running sum of squared deviations
+};
+
+// Stuck value: the sensor repeats exactly the same sample
+class StuckDetector
+{
+    public:
+        // Feed a sample; returns true while the sensor is stuck
+        bool update(const std::array<double, 3>& values, std::size_t limit);
+
+        void reset() { repeats_ = 0; has_last_ = false; }
+
+    private:
+        std::array<double, 3> last_{};  // Previous sample
+        std::size_t repeats_ = 0;       // Consecutive repetitions
+        bool has_last_ = false;         // A previous sample exists
+};
+
+// Noise variance drift: Welford variance of the sample-to-sample differences over blocks
+// (differencing removes the slowly varying signal; its variance is twice the noise variance)
+class NoiseDetector
+{
+    public:
+        // Feed a sample; returns true while the last complete block was out of range
+        bool update(const std::array<double, 3>& values, double noise, const DetectorConfig& config);
+
+        void reset();
+
+    private:
+        std::array<RunningStats, 3> differences_;  // Statistics of the current block
+        std::array<double, 3> last_{};              // Previous sample
+        bool has_last_ = false;                     // A previous sample exists
+        bool drift_ = false;                        // Result of the last complete block
+};
+
+// Bias step change: two-sided CUSUM on a residual that should be zero-mean
+class CusumDetector
+{
+    public:
+        // Feed a residual (in noise units); returns true while a step is detected
+        bool update(const std::array<double, 3>& residual, const DetectorConfig& config);
+
+        void reset() { high_.fill(0.0); low_.fill(0.0); }
+
+    private:
+        std::array<double, 3> high_{};     // Upward cumulative sums
+        std::array<double, 3> low_{};      // Downward cumulative sums
+};
+
+// Median vote: a unit far from the median of its redundant group for several samples is isolated
+class VoteDetector
+{
+    public:
+        // Feed the distance from the group median (in noise units); returns true while isolated
+        bool update(const std::array<double, 3>& residual, const DetectorConfig& config);
+
+        void reset() { disagreements_ = 0; }
+
+    private:
+        std::size_t disagreements_ = 0;    // Consecutive samples far from the median
+};
+
+// Faults found by the detectors of one sensor
+struct SampleFaults
+{
+    bool stuck = false;
+    bool noise = false;
+    bool bias = false;
+    bool outvoted = false;
+
+    bool operator==(const SampleFaults& other) const
+    {
+        return stuck == other.stuck && noise == other.noise && bias == other.bias && outvoted == other.outvoted;
+    }
+    bool operator!=(const SampleFaults& other) const { return !(*this == other); }
+};
+
+// Full detector set of one sensor
+class SensorDetectors
+{
+    public:
+        // Feed a sample. median is the median of the sensor's redundant group at the sample time
+        // (nullopt without a group: no bias check); a unit is isolated by vote only in groups of 3 or more.
+        void update(const std::array<double, 3>& values, const std::optional<std::array<double, 3>>& median,
+                    bool voting, double noise, const DetectorConfig& config);
+
+        // Current faults
+        const SampleFaults& faults() const { return faults_; }
+
+        // Clear the detector state (sensor restarted)
+        void reset();
+
+    private:
+        StuckDetector stuck_;
+        NoiseDetector noise_;
+        CusumDetector cusum_;
+        VoteDetector vote_;
+        SampleFaults faults_;                       // Current faults
+};
@@ -3,18 +3,59 @@
 #include "../sensors/Sensor.hpp"
 #include "../processing/ProcessingUnit.hpp"
 #include "../logging/Logger.hpp"
+#include "../scheduling/Executor.hpp"
+#include "../scheduling/PeriodicTimer.hpp"
+#include "../metrics/LatencyHistogram.hpp"
+#include "../metrics/ComponentMetrics.hpp"
+#include "../transport/MessageBus.hpp"
+#include "Detectors.hpp"
 #include <unordered_map>
 #include <memory>
 #include <thread>
 #include <mutex>
 #include <atomic>
 #include <condition_variable>
+#include <queue>
+#include <vector>
 
-class Fdir 
+// Faults reported by FDIR since its last start
+struct FdirDetections
+{
+    std::uint64_t silent = 0;           // Sensors without output for three nominal intervals
+    std::uint64_t recovered = 0;        // Silent sensors providing output again
+    std::uint64_t stuck = 0;            // Stuck value faults
+    std::uint64_t noise = 0;            // Noise drift faults
+    std::uint64_t bias = 0;             // Bias step faults against the group
+    std::uint64_t outvoted = 0;         // Sensors isolated by the group median vote
+    std::uint64_t invalid_output = 0;   // Processing unit outputs turning invalid
+};
+
+// Fault reported on the fdir/alarms topic
+enum class FdirAlarmKind : std::uint8_t { Silent, Stuck, Noise, Bias, Outvoted, InvalidOutput };
+
+// Alarm published on the fdir/alarms topic when a fault is reported and when it clears
+struct FdirAlarm
+{
+    std::int64_t time_ns;       // Report time (steady clock)
+    FdirAlarmKind kind;         // Fault
+    bool active;                // Fault raised (true) or cleared (false)
+    char source[32];            // Sensor name, or "processing_unit" (NUL-terminated)
+};
+
+// Fault detection, isolation and recovery.
+// Sensors are kept in a dense array and publish an atomic heartbeat (time of their last sample).
+// Each sensor has a failure deadline (last heartbeat + three nominal periods) in a min-heap,
+// so a tick only inspects the sensors whose deadline has passed, not every registered sensor.
+// New samples are also read from the sensor buffers in place and fed to streaming detectors
+// (stuck value, noise drift, bias step, median vote within a redundant group). A sensor queues
+// itself once when it has new samples, so a pass only visits those sensors.
+// The processing unit outputs are read from the fusion/output topic, and every report is also
+// published as an FdirAlarm on the fdir/alarms topic.
+class Fdir
 {
     public:
-        // Constructor
-        Fdir(std::shared_ptr<ProcessingUnit> processing_unit, double frequency);
+        // Constructor (frequency 0 = run at the lowest registered sensor frequency)
+        Fdir(std::shared_ptr<ProcessingUnit> processing_unit, double frequency = 0.0);
 
         // Destructor
         ~Fdir() = default;
@@ -25,27 +66,144 @@ class Fdir
         // Stop the FDIR thread
         void stop();
 
-        // Add a sensor
-        void addSensor(std::shared_ptr<Sensor> sensor);
+        // Add a sensor, optionally to a group of redundant units voting against each other
+        void addSensor(std::shared_ptr<Sensor> sensor, const std::string& group = "");
 
         // Remove a sensor
         void removeSensor(const std::string& name);
 
+        // Get the FDIR frequency in Hz
+        double getFrequency() const { return frequency_; }
+
+        // Run FDIR on an executor instead of its own thread (set before start())
+        void setExecutor(std::shared_ptr<Executor> executor) { executor_ = std::move(executor); }
+
+        // Get the period error and jitter of the FDIR loop since the last start
+        TimingStats getTimingStats() const { return timing_.stats(); }
+
+        // Get the live counters of the FDIR loop since the last start: samples checked and skipped
+        // (overwritten before being read), waits for fdir_mutex_
+        const ComponentMetrics& getMetrics() const { return metrics_; }
+
+        // Get the faults reported since the last start
+        FdirDetections getDetections() const;
+
+        // Get the alarm topic "fdir/alarms"
+        std::shared_ptr<Topic<FdirAlarm>> getAlarmTopic() const { return alarm_topic_; }
+
+        // Get the FDIR latencies since the last start: sample generation to detector decision,
+        // and last output to the report of a silent sensor
+        std::vector<const LatencyTracker*> getLatencyTrackers() const { return {&sample_latency_, &silence_latency_}; }
+
     private:
+        // Monitored sensor (dense slot)
+        struct MonitoredSensor
+        {
+            std::shared_ptr<Sensor> sensor;     // Sensor (nullptr = free slot)
+            std::string name;                   // Sensor name
+            std::int64_t period_ns;             // Nominal measurement interval
+            std::int64_t since_ns;              // Start of the current monitoring window
+            std::uint32_t generation;           // Incremented when the slot is freed (stale heap entries)
+            bool failed;                        // Failure reported, waiting for recovery
+            std::size_t group;                  // Redundancy group (no_group if none)
+            std::uint64_t cursor;               // Index of the next sample to feed the detectors
+            Sensor::Sample next;                // Next sample, read ahead to merge the group in time order
+            bool has_next;                      // next holds the sample at cursor
+            std::array<double, 3> last_values;  // Last sample fed to the detectors
+            std::int64_t last_ns;               // Time of that sample (0 = none)
+            SensorDetectors detectors;          // Streaming detectors
+            SampleFaults reported;              // Faults already reported
+        };
+
+        // Group of redundant sensors
+        struct Group
+        {
+            std::string name;
+            std::vector<std::size_t> slots;
+            std::vector<std::size_t> ready;     // Units with new samples in the current pass
+        };
+
+        static constexpr std::size_t no_group = static_cast<std::size_t>(-1);
+
+        // Most units voting in a group median (larger groups vote through a spread subset)
+        static constexpr std::size_t max_voters = 31;
+
+        // Merge heap entry: time of the pending sample of a slot
+        struct PendingSample
+        {
+            std::int64_t time_ns;
+            std::size_t slot;
+        };
+
+        // Heap entry: failure deadline of a slot
+        struct Deadline
+        {
+            std::int64_t deadline_ns;
+            std::size_t slot;
+            std::uint32_t generation;
+            bool operator>(const Deadline& other) const { return deadline_ns > other.deadline_ns; }
+        };
+
         // Processing unit loop
         void run();
 
-        // Check the sensors status
+        // One iteration of the FDIR loop
+        void tick();
+
+        // Check the sensors whose failure deadline has passed
         void checkSensors();
 
+        // Feed the new samples of the sensors queued since the last pass to their detectors and report the changes
+        void checkSamples();
+
+        // Feed the new samples of a set of sensors of one group (or no_group), merged in time order
+        // (lock held, now = cycle time)
+        void feedDetectors(const std::size_t* slots, std::size_t count, std::size_t group, std::int64_t now,
+                           std::vector<std::pair<Logger::Level, std::string>>& reports);
+
+        // Read the sample at the cursor of a slot, if any (lock held)
+        bool readAhead(MonitoredSensor& monitored);
+
+        // Median of the group values from a bounded set of voters with recent data (lock held, once
+        // per cycle). units receives the number of voters; nullopt with fewer than two.
+        std::optional<std::array<double, 3>> groupMedian(const Group& group, std::size_t& units);
+
         // Check the processing unit status
         void checkProcessingUnit();
 
-        double frequency_;
-        std::shared_ptr<ProcessingUnit> processing_unit_; // Processing unit instance
-        std::unordered_map<std::string, std::tuple<std::shared_ptr<Sensor>, int, double>> sensors_; // Sensor name : [Sensor pointer, counter, measurement frequency]
-        std::mutex fdir_mutex_;
-        bool running_;
+        // Publish an alarm on fdir/alarms (FDIR loop only)
+        void publishAlarm(FdirAlarmKind kind, bool active, const std::string& source, std::int64_t now);
+
+        // Frequency from the registered sensors, if not fixed (lock held)
+        void updateFrequency();
+
+        // Push the failure deadline of a slot (lock held)
+        void schedule(std::size_t slot, std::int64_t deadline_ns);
+
+        std::atomic<double> frequency_;                     // Frequency in Hz
+        bool derived_frequency_;                            // Frequency follows the lowest sensor frequency
+        std::shared_ptr<ProcessingUnit> processing_unit_;   // Processing unit instance
+        std::vector<MonitoredSensor> sensors_;              // Dense sensor slots
+        std::vector<std::size_t> free_slots_;               // Slots of removed sensors
+        std::unordered_map<std::string, std::size_t> slot_by_name_;     // Sensor name : slot (add/remove only)
+        std::priority_queue<Deadline, std::vector<Deadline>, std::greater<Deadline>> deadlines_; // Failure deadlines
+        std::vector<Group> groups_;                         // Redundancy groups
+        DetectorConfig detector_config_;                    // Detector thresholds
+        std::vector<PendingSample> merge_heap_;             // Pending samples of a group, oldest first
+        std::shared_ptr<MpscQueue<std::uint64_t>> sample_queue_;    // Sensors with new samples (generation << 32 | slot)
+        std::vector<std::uint64_t> ready_tokens_;           // Tokens taken from sample_queue_ in the current pass
+        std::vector<std::size_t> ready_groups_;             // Groups with new samples in the current pass
+        FdirDetections detections_;                         // Faults reported since the last start
+        mutable std::mutex fdir_mutex_;                     // Protects the slots, the deadlines and the detections
+        std::atomic<bool> running_{false};
         std::thread thread_;
+        std::shared_ptr<Executor> executor_;    // Optional executor (replaces thread_)
+        Executor::TaskId task_id_ = 0;          // Task on the executor
+        TimingMonitor timing_;                  // Activation period and jitter
+        LatencyTracker sample_latency_{"sample_to_fdir"};       // Sample age when the detectors decide
+        ComponentMetrics metrics_;              // Ticks, samples checked and skipped, fdir_mutex_ waits
+        LatencyTracker silence_latency_{"silence_to_fdir"};     // Last output to the failure report
+        std::shared_ptr<Subscription<ProcessingOutput>> output_subscription_;  // Processing unit outputs
+        std::shared_ptr<Topic<FdirAlarm>> alarm_topic_;                         // Published alarms
         bool valid_data_ = false; // Flag to indicate if the Processing Unit data is valid
 };
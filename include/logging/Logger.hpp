@@ -1,8 +1,16 @@
 #pragma once
 #include <string>
+#include <string_view>
 #include <iostream>
 #include <mutex>
 #include <fstream>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include "MpscQueue.hpp"
 
 class Logger {
 public:
@@ -14,14 +22,81 @@ public:
         Error
     };
 
-    // Constructor: create the log file
+    // Behaviour when the message queue is full
+    enum class OverflowPolicy {
+        Drop,   // Discard the message and count it
+        Block   // Wait for the writer thread to make room
+    };
+
+    // Logger configuration
+    struct Config {
+        bool asynchronous = true;                                   // Write from a background thread
+        std::size_t queue_capacity = 4096;                          // Maximum number of queued messages
+        std::size_t batch_size = 256;                               // Maximum messages written per batch
+        std::chrono::milliseconds flush_interval{100};              // Maximum time before a file flush
+        OverflowPolicy overflow_policy = OverflowPolicy::Drop;      // Full queue behaviour
+        bool console = true;                                        // Echo the messages to stdout/stderr
+        std::string directory = "../log";                           // Log file directory
+    };
+
+    // Constructor: create the log file and start the writer thread.
+    // init() and shutdown() replace the queue and the writer: they must not run while another
+    // thread may call log(), i.e. call them before starting the components and after stopping them.
     static void init();
 
-    // Log a message with a specific level
-    static void log(Level level, const std::string& message);
+    // Constructor with an explicit configuration (same threading rule as init())
+    static void init(const Config& config);
+
+    // Drain the queue, stop the writer thread and flush the log file (later messages are written
+    // synchronously; same threading rule as init())
+    static void shutdown();
+
+    // Log a message with a specific level. The message is copied into a preallocated queue
+    // record, so logging a literal or a short message does not allocate.
+    static void log(Level level, std::string_view message);
+
+    // Number of messages dropped because the queue was full
+    static std::uint64_t droppedCount() { return dropped_; }
+
+    // Messages waiting for the writer thread (approximate) and queue capacity (0 when synchronous)
+    static std::size_t queueDepth() { return queue_ ? queue_->size() : 0; }
+    static std::size_t queueCapacity() { return queue_ ? queue_->capacity() : 0; }
 
 private:
+    // Queued log record: the text is stored inline, only longer messages spill to the heap
+    struct Record {
+        static constexpr std::size_t inline_capacity = 200;   // Longer than any periodic message
+
+        Level level = Level::Info;
+        std::uint32_t length = 0;       // Inline text length
+        char text[inline_capacity];     // Inline text (not NUL-terminated)
+        std::string overflow;           // Text of a longer message
+
+        // Set the text
+        void assign(std::string_view message);
+
+        // Get the text
+        std::string_view message() const { return overflow.empty() ? std::string_view(text, length) : std::string_view(overflow); }
+    };
+
+    // Writer thread loop
+    static void writerLoop();
+
+    // Write a message synchronously (no writer thread running)
+    static void writeSync(Level level, std::string_view message);
+
+    // Append a formatted record to a text buffer
+    static void format(std::string& buffer, const Record& record);
+
     static std::ofstream logfile_; // Log file stream
     static std::string filename_; // Log file name
     static std::mutex log_mutex_; // Mutex for thread-safe logging
-};
\ No newline at end of file
+    static Config config_; // Active configuration
+    static std::unique_ptr<MpscQueue<Record>> queue_; // Lock-free message queue
+    static std::thread writer_; // Background writer thread
+    static std::atomic<bool> running_; // Writer thread control flag
+    static std::atomic<bool> writer_idle_; // Writer waiting for new messages
+    static std::mutex wake_mutex_; // Mutex for the writer wake-up
+    static std::condition_variable wake_; // Writer wake-up
+    static std::atomic<std::uint64_t> dropped_; // Messages dropped on overflow
+};
@@ -0,0 +1,105 @@
+#pragma once // Avoid multiple inclusion
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+// Bounded lock-free multi-producer single-consumer queue.
+// Each cell carries a sequence number telling producers and the consumer
+// whether it is free or holds a value, so neither side ever takes a lock.
+template <typename T>
+class MpscQueue
+{
+    public:
+        // Constructor: capacity is rounded up to a power of two
+        explicit MpscQueue(std::size_t capacity)
+            : mask_(roundUp(capacity) - 1), cells_(new Cell[mask_ + 1])
+        {
+            for (std::size_t i = 0; i <= mask_; i++)
+                cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        MpscQueue(const MpscQueue&) = delete;
+        MpscQueue& operator=(const MpscQueue&) = delete;
+
+        // Enqueue a value (any thread). Returns false if the queue is full.
+        bool tryPush(T&& value)
+        {
+            std::size_t position = enqueue_pos_.load(std::memory_order_relaxed);
+            while (true)
+            {
+                Cell& cell = cells_[position & mask_];
+                const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+                const std::intptr_t diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+
+                if (diff == 0)
+                {
+                    // Cell is free: try to claim it
+                    if (enqueue_pos_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    {
+                        cell.value = std::move(value);
+                        cell.sequence.store(position + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (diff < 0)
+                {
+                    return false; // Full
+                }
+                else
+                {
+                    position = enqueue_pos_.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        // Dequeue a value (consumer thread only). Returns false if the queue is empty.
+        bool tryPop(T& value)
+        {
+            const std::size_t position = dequeue_pos_.load(std::memory_order_relaxed);
+            Cell& cell = cells_[position & mask_];
+            const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            if (sequence != position + 1)
+                return false; // Empty (or the producer has not finished writing)
+
+            value = std::move(cell.value);
+            cell.sequence.store(position + mask_ + 1, std::memory_order_release);
+            dequeue_pos_.store(position + 1, std::memory_order_relaxed);
+            return true;
+        }
+
+        // Get the queue capacity
+        std::size_t capacity() const { return mask_ + 1; }
+
+        // Approximate number of queued values (any thread, for monitoring)
+        std::size_t size() const
+        {
+            const std::size_t dequeued = dequeue_pos_.load(std::memory_order_relaxed);
+            const std::size_t enqueued = enqueue_pos_.load(std::memory_order_relaxed);
+            return enqueued > dequeued ? std::min(enqueued - dequeued, capacity()) : 0;
+        }
+
+    private:
+        // Queue cell, padded to avoid false sharing between producers
+        struct alignas(64) Cell
+        {
+            std::atomic<std::size_t> sequence;
+            T value;
+        };
+
+        // Round the capacity up to the next power of two
+        static std::size_t roundUp(std::size_t capacity)
+        {
+            std::size_t size = 2;
+            while (size < capacity)
+                size <<= 1;
+            return size;
+        }
+
+        const std::size_t mask_;                                // Capacity - 1
+        std::unique_ptr<Cell[]> cells_;                         // Queue storage
+        alignas(64) std::atomic<std::size_t> enqueue_pos_{0};   // Shared by the producers
+        alignas(64) std::atomic<std::size_t> dequeue_pos_{0};   // Written by the consumer only
+};
@@ -0,0 +1,129 @@
+#pragma once // Avoid multiple inclusion
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+// Live counters of one component: loop ticks, samples and lock waits.
+// Written only by the thread running the component (relaxed load and store, no read-modify-write,
+// so nothing is contended on the hot path) and read by the metrics snapshot from any thread.
+// Aligned on a cache line so that the counters of two components never share one.
+class alignas(64) ComponentMetrics
+{
+    public:
+        // Values at one point in time
+        struct Snapshot
+        {
+            std::uint64_t ticks = 0;                // Loop iterations
+            std::uint64_t tick_ns_total = 0;        // Time spent in the iterations
+            std::uint64_t tick_ns_max = 0;          // Longest iteration
+            std::uint64_t produced = 0;             // Samples or outputs produced (or checked)
+            std::uint64_t dropped = 0;              // Samples or outputs lost
+            std::uint64_t lock_acquisitions = 0;    // Metered mutex acquisitions
+            std::uint64_t lock_contended = 0;       // Acquisitions that had to wait
+            std::uint64_t lock_wait_ns_total = 0;   // Time spent waiting for the mutex
+            std::uint64_t lock_wait_ns_max = 0;     // Longest wait
+        };
+
+        // Record one loop iteration
+        void recordTick(std::int64_t duration_ns)
+        {
+            add(ticks_, 1);
+            add(tick_ns_total_, clamp(duration_ns));
+            raise(tick_ns_max_, clamp(duration_ns));
+        }
+
+        // Count produced and lost samples
+        void addProduced(std::uint64_t count = 1) { add(produced_, count); }
+        void addDropped(std::uint64_t count = 1) { add(dropped_, count); }
+
+        // Record one acquisition of the metered mutex (wait 0 = not contended)
+        void recordLock(std::int64_t wait_ns)
+        {
+            add(lock_acquisitions_, 1);
+            if (wait_ns <= 0)
+                return;
+            add(lock_contended_, 1);
+            add(lock_wait_ns_total_, clamp(wait_ns));
+            raise(lock_wait_ns_max_, clamp(wait_ns));
+        }
+
+        // Read the counters (any thread)
+        Snapshot snapshot() const
+        {
+            Snapshot snapshot;
+            snapshot.ticks = ticks_.load(std::memory_order_relaxed);
+            snapshot.tick_ns_total = tick_ns_total_.load(std::memory_order_relaxed);
+            snapshot.tick_ns_max = tick_ns_max_.load(std::memory_order_relaxed);
+            snapshot.produced = produced_.load(std::memory_order_relaxed);
+            snapshot.dropped = dropped_.load(std::memory_order_relaxed);
+            snapshot.lock_acquisitions = lock_acquisitions_.load(std::memory_order_relaxed);
+            snapshot.lock_contended = lock_contended_.load(std::memory_order_relaxed);
+            snapshot.lock_wait_ns_total = lock_wait_ns_total_.load(std::memory_order_relaxed);
+            snapshot.lock_wait_ns_max = lock_wait_ns_max_.load(std::memory_order_relaxed);
+            return snapshot;
+        }
+
+        // Clear the counters (the writer must be idle, e.g. before a start)
+        void reset()
+        {
+            for (std::atomic<std::uint64_t>* counter : {&ticks_, &tick_ns_total_, &tick_ns_max_, &produced_, &dropped_,
+                                                        &lock_acquisitions_, &lock_contended_, &lock_wait_ns_total_, &lock_wait_ns_max_})
+                counter->store(0, std::memory_order_relaxed);
+        }
+
+    private:
+        static std::uint64_t clamp(std::int64_t value) { return value > 0 ? static_cast<std::uint64_t>(value) : 0; }
+
+        // Single writer: a plain load and store instead of an atomic read-modify-write
+        static void add(std::atomic<std::uint64_t>& counter, std::uint64_t value)
+        {
+            counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        }
+
+        static void raise(std::atomic<std::uint64_t>& counter, std::uint64_t value)
+        {
+            if (value > counter.load(std::memory_order_relaxed))
+                counter.store(value, std::memory_order_relaxed);
+        }
+
+        std::atomic<std::uint64_t> ticks_{0};
+        std::atomic<std::uint64_t> tick_ns_total_{0};
+        std::atomic<std::uint64_t> tick_ns_max_{0};
+        std::atomic<std::uint64_t> produced_{0};
+        std::atomic<std::uint64_t> dropped_{0};
+        std::atomic<std::uint64_t> lock_acquisitions_{0};
+        std::atomic<std::uint64_t> lock_contended_{0};
+        std::atomic<std::uint64_t> lock_wait_ns_total_{0};
+        std::atomic<std::uint64_t> lock_wait_ns_max_{0};
+};
+
+// Lock guard recording the acquisitions of a mutex and the time spent waiting for it.
+// The clock is only read when the mutex is contended (try_lock failed).
+class MeteredLock
+{
+    public:
+        // Constructor: lock the mutex (component thread of the metrics)
+        MeteredLock(std::mutex& mutex, ComponentMetrics& metrics) : mutex_(mutex)
+        {
+            if (mutex_.try_lock())
+            {
+                metrics.recordLock(0);
+                return;
+            }
+            const auto start = std::chrono::steady_clock::now();
+            mutex_.lock();
+            metrics.recordLock(std::max<std::int64_t>(1, std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start).count()));
+        }
+
+        // Destructor: unlock the mutex
+        ~MeteredLock() { mutex_.unlock(); }
+
+        MeteredLock(const MeteredLock&) = delete;
+        MeteredLock& operator=(const MeteredLock&) = delete;
+
+    private:
+        std::mutex& mutex_;
+};
@@ -0,0 +1,102 @@
+#pragma once // Avoid multiple inclusion
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Percentiles of a latency distribution
+struct LatencySummary
+{
+    std::uint64_t count = 0;    // Recorded values
+    double p50_us = 0.0;        // Median
+    double p99_us = 0.0;        // 99th percentile
+    double p999_us = 0.0;       // 99.9th percentile
+    double max_us = 0.0;        // Largest value
+
+    // Format as "n=..., p50 ... us, p99 ... us, p99.9 ... us, max ... us"
+    std::string format() const;
+};
+
+// HDR-style histogram of latencies in ns: values below 64 ns have their own bucket, above that
+// every power of two is split into 64 linear sub-buckets, so any value up to 2^41 ns (about
+// 36 minutes) is kept with a relative error below 1/64 in a fixed 18 KB array.
+// Single writer: record() uses relaxed loads and stores, no read-modify-write; readers may
+// merge the counts at any time and see a consistent-enough snapshot.
+class LatencyHistogram
+{
+    public:
+        static constexpr unsigned sub_bucket_bits = 6;                          // log2 of the sub-buckets per power of two
+        static constexpr std::size_t sub_buckets = std::size_t(1) << sub_bucket_bits;
+        static constexpr unsigned max_exponent = 40;                            // Highest power of two kept apart
+        static constexpr std::size_t bucket_count = (max_exponent - sub_bucket_bits + 2) * sub_buckets;
+
+        // Record one value (writer thread only; negative values count as 0, larger ones as the maximum)
+        void record(std::int64_t value_ns)
+        {
+            const std::uint64_t value = value_ns > 0 ? static_cast<std::uint64_t>(value_ns) : 0;
+            std::atomic<std::uint64_t>& bucket = counts_[bucketOf(value)];
+            bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            if (value > max_.load(std::memory_order_relaxed))
+                max_.store(value, std::memory_order_relaxed);
+        }
+
+        // Add the counts to a merge buffer of bucket_count entries, and the maximum
+        void mergeInto(std::vector<std::uint64_t>& counts, std::uint64_t& max) const;
+
+        // Clear the counts (the writer must be idle)
+        void reset();
+
+        // Bucket of a value
+        static std::size_t bucketOf(std::uint64_t value)
+        {
+            if (value < sub_buckets)
+                return static_cast<std::size_t>(value);
+            const unsigned exponent = 63u - static_cast<unsigned>(__builtin_clzll(value));
+            if (exponent > max_exponent)
+                return bucket_count - 1;
+            const std::size_t mantissa = static_cast<std::size_t>(value >> (exponent - sub_bucket_bits));   // [64, 128)
+            return (exponent - sub_bucket_bits + 1) * sub_buckets + (mantissa - sub_buckets);
+        }
+
+        // Middle of the value range of a bucket
+        static double valueOf(std::size_t bucket);
+
+    private:
+        std::array<std::atomic<std::uint64_t>, bucket_count> counts_{};     // Values per bucket
+        std::atomic<std::uint64_t> max_{0};                                 // Largest value recorded
+};
+
+// Latency metric recorded from any number of threads. Every thread writes its own histogram,
+// found through a thread-local cache (no shared cache line, no lock on the hot path); the
+// histograms are merged only when a summary is requested.
+class LatencyTracker
+{
+    public:
+        // Constructor
+        explicit LatencyTracker(std::string name);
+
+        // Get the metric name
+        const std::string& getName() const { return name_; }
+
+        // Record one latency in ns (calling thread's histogram)
+        void record(std::int64_t latency_ns);
+
+        // Merge the per-thread histograms into percentiles
+        LatencySummary summary() const;
+
+        // Clear every histogram (the writers must be idle, e.g. before a start)
+        void reset();
+
+    private:
+        // Histogram of the calling thread (created on its first record)
+        LatencyHistogram& local();
+
+        const std::uint64_t id_;                                // Unique id (key of the thread-local caches)
+        std::string name_;                                      // Metric name
+        mutable std::mutex shards_mutex_;                       // Protects the list of histograms
+        std::vector<std::unique_ptr<LatencyHistogram>> shards_; // One histogram per writer thread
+};
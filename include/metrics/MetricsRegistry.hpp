@@ -0,0 +1,70 @@
+#pragma once // Avoid multiple inclusion
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "ComponentMetrics.hpp"
+#include "../scheduling/PeriodicTimer.hpp"
+
+// Component registered in the metrics registry (every field but the names is optional)
+struct MetricsSource
+{
+    std::string component;                                          // Component name (label)
+    std::string kind;                                               // Component type (label)
+    const ComponentMetrics* counters = nullptr;                     // Tick, sample and lock counters
+    std::string lock;                                               // Name of the metered mutex (label)
+    std::function<TimingStats()> timing;                            // Activation statistics (deadline overruns)
+    std::function<std::pair<std::size_t, std::size_t>()> buffer;    // Buffer or queue occupancy and capacity
+    std::function<std::uint64_t()> dropped;                         // Losses counted by the component itself
+};
+
+// Runtime metrics of the simulation components, rendered in the Prometheus text format.
+// Reading the metrics never blocks the components: the counters are single-writer atomics,
+// the buffer sizes are read from the lock-free indexes. An optional exporter thread writes
+// the snapshot to a file at a fixed interval (written aside and renamed, so that a scraper
+// never reads a partial file).
+class MetricsRegistry
+{
+    public:
+        // Destructor: stop the exporter
+        ~MetricsRegistry();
+
+        // Register a component (before startExport())
+        void add(MetricsSource source);
+
+        // Register families rendered by their owner in the same text format, e.g. the message bus
+        // (before startExport(); appended to every snapshot)
+        void addFamilies(std::function<std::string()> render);
+
+        // Snapshot of every metric in the Prometheus text exposition format
+        std::string prometheus() const;
+
+        // Write the snapshot to a file every interval, from a dedicated thread
+        // (false, logged, if the file directory cannot be created: nothing is exported)
+        bool startExport(const std::string& path, std::chrono::milliseconds interval);
+
+        // Stop the exporter thread, writing a last snapshot
+        void stopExport();
+
+    private:
+        // Exporter thread loop
+        void exportLoop();
+
+        // Write the snapshot file
+        bool writeSnapshot() const;
+
+        std::vector<MetricsSource> sources_;            // Registered components
+        std::vector<std::function<std::string()>> renderers_;   // Families rendered by their owner
+        std::string path_;                              // Snapshot file
+        std::chrono::milliseconds interval_{1000};      // Export interval
+        std::thread thread_;                            // Exporter thread
+        bool exporting_ = false;                        // Exporter control flag
+        std::mutex export_mutex_;                       // Protects the control flag
+        std::condition_variable wake_;                  // Exporter wake-up on stop
+};
@@ -0,0 +1,54 @@
+#pragma once // Avoid multiple inclusion
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <vector>
+#include "../sensors/ImuSensor.hpp"
+#include "ImuSnapshot.hpp"
+
+// Time-aligned fusion of several IMUs.
+// Every IMU is resampled at a common fusion timestamp by linear interpolation over its last
+// `window` buffered samples, then the resampled values are averaged. The fusion timestamp is
+// the oldest of the latest samples, so every IMU brackets it and nothing is extrapolated.
+// The work per cycle is a fixed-size kernel per IMU, whatever the sensor rates; the resampled
+// channels are then reduced by the SIMD masked mean/variance kernel of ImuSnapshot.
+class ImuFusion
+{
+    public:
+        // Samples per IMU used for the interpolation
+        static constexpr std::size_t window = 8;
+
+        // Fused attitude rate
+        struct Result
+        {
+            Sensor::Timestamp timestamp;        // Common fusion timestamp
+            std::array<double, 3> values;       // Mean attitude rate at the fusion timestamp
+            std::array<double, 3> variance;     // Spread of the IMUs around the mean
+            std::size_t imu_count;              // IMUs contributing
+        };
+
+        // Constructor: storage for the given IMUs is allocated once
+        explicit ImuFusion(std::vector<std::shared_ptr<ImuSensor>> imu_sensors);
+
+        // Fuse the IMUs with valid data; nullopt when there is none
+        std::optional<Result> fuse();
+
+    private:
+        // Window of one IMU (structure of arrays, times relative to the fusion timestamp)
+        struct alignas(64) Window
+        {
+            Sensor::Timestamp timestamps[window];   // Sample times, oldest first
+            double dt[window + 1];                  // Sample time - fusion time in ns (+inf sentinel last)
+            double values[3][window + 1];           // One row per axis (newest value repeated last)
+            std::size_t count;                      // Samples copied (missing ones padded with the oldest)
+            bool active;                            // Valid and not stale
+        };
+
+        // Copy the last samples of an IMU into its window (padding in front to the fixed size)
+        static void load(const ImuSensor& imu, Window& window);
+
+        std::vector<std::shared_ptr<ImuSensor>> imu_sensors_;   // Fused IMUs
+        std::vector<Window> windows_;                           // One window per IMU
+        ImuSnapshot snapshot_;                                  // Resampled channels (one per IMU)
+};
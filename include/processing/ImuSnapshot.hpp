@@ -0,0 +1,61 @@
+#pragma once // Avoid multiple inclusion
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Attitude rates of many IMU channels, structure of arrays.
+// One array per axis and a validity bitmask (bit i of word i / 64 set = channel i valid).
+// The arrays are padded with zeros to a multiple of 8 channels, so the SIMD kernels
+// never need a remainder loop. Storage is allocated by resize() only.
+struct ImuSnapshot
+{
+    std::vector<double> x;              // Attitude rate x per channel
+    std::vector<double> y;              // Attitude rate y per channel
+    std::vector<double> z;              // Attitude rate z per channel
+    std::vector<std::uint64_t> valid;   // Validity bitmask
+    std::size_t channels = 0;           // Number of channels
+
+    // Set the number of channels (all invalid)
+    void resize(std::size_t count)
+    {
+        channels = count;
+        const std::size_t padded = (count + 7) / 8 * 8;
+        x.assign(padded, 0.0);
+        y.assign(padded, 0.0);
+        z.assign(padded, 0.0);
+        valid.assign((padded + 63) / 64, 0);
+    }
+
+    // Store the values of a channel and mark it valid
+    void set(std::size_t channel, double value_x, double value_y, double value_z)
+    {
+        x[channel] = value_x;
+        y[channel] = value_y;
+        z[channel] = value_z;
+        valid[channel / 64] |= std::uint64_t(1) << (channel % 64);
+    }
+
+    // Mark a channel invalid (its values are ignored)
+    void invalidate(std::size_t channel) { valid[channel / 64] &= ~(std::uint64_t(1) << (channel % 64)); }
+};
+
+// Mean and variance over the valid channels
+struct ImuStatistics
+{
+    std::array<double, 3> mean;         // Mean per axis
+    std::array<double, 3> variance;     // Sample variance per axis (0 if not computed or fewer than 2 channels)
+    std::size_t count;                  // Valid channels
+};
+
+// Instruction set used by the fusion kernel
+enum class SimdLevel { Scalar, Sse2, Avx2 };
+
+// Best instruction set supported by this CPU
+SimdLevel detectSimdLevel();
+
+// Masked mean (and variance, in the same pass) of the valid channels, on the best instruction set
+ImuStatistics fuseImuSnapshot(const ImuSnapshot& snapshot, bool with_variance);
+
+// Same as above on a given instruction set (falls back to scalar if not supported)
+ImuStatistics fuseImuSnapshot(const ImuSnapshot& snapshot, bool with_variance, SimdLevel level);
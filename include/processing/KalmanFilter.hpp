@@ -0,0 +1,64 @@
+#pragma once // Avoid multiple inclusion
+#include <cstddef>
+#include <optional>
+#include "Matrix.hpp"
+
+// Linear Kalman filter on an error state of N components, with compile-time dimensions.
+// It only holds the error covariance: the caller propagates its nominal state, provides the
+// linearized transition and observation matrices, and folds the returned correction back in.
+template <std::size_t N>
+class KalmanFilter
+{
+    public:
+        using State = Matrix<N, 1>;
+        using Covariance = Matrix<N, N>;
+
+        // Set the error covariance
+        void reset(const Covariance& covariance) { covariance_ = covariance; }
+
+        // Propagate the error covariance: P = F P F^T + Q
+        void predict(const Covariance& transition, const Covariance& process_noise)
+        {
+            covariance_ = transition * covariance_ * transition.transposed() + process_noise;
+            symmetrize();
+        }
+
+        // Correct with a measurement of M components (innovation = measurement - predicted measurement);
+        // returns the error-state correction, nullopt if the innovation covariance is singular
+        template <std::size_t M>
+        std::optional<State> update(const Matrix<M, 1>& innovation, const Matrix<M, N>& observation,
+                                    const Matrix<M, M>& measurement_noise)
+        {
+            // Gain K = P H^T (H P H^T + R)^-1
+            const Matrix<N, M> covariance_observation = covariance_ * observation.transposed();
+            Matrix<M, M> innovation_inverse;
+            if (!invertSymmetric(observation * covariance_observation + measurement_noise, innovation_inverse))
+                return std::nullopt;
+            const Matrix<N, M> gain = covariance_observation * innovation_inverse;
+
+            // Joseph form P = (I - K H) P (I - K H)^T + K R K^T (stays positive definite)
+            const Covariance reduction = Covariance::identity() - gain * observation;
+            covariance_ = reduction * covariance_ * reduction.transposed()
+                + gain * measurement_noise * gain.transposed();
+            symmetrize();
+            return gain * innovation;
+        }
+
+        // Current error covariance
+        const Covariance& covariance() const { return covariance_; }
+
+    private:
+        // Remove the rounding asymmetry
+        void symmetrize()
+        {
+            for (std::size_t i = 0; i < N; i++)
+                for (std::size_t j = i + 1; j < N; j++)
+                {
+                    const double value = 0.5 * (covariance_(i, j) + covariance_(j, i));
+                    covariance_(i, j) = value;
+                    covariance_(j, i) = value;
+                }
+        }
+
+        Covariance covariance_ = Covariance::identity();   // Error covariance P
+};
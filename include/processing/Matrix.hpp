@@ -0,0 +1,148 @@
+#pragma once // Avoid multiple inclusion
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+// Fixed-size dense matrix with compile-time dimensions, stored row-major in place (no heap).
+// Every loop has a compile-time trip count, so the compiler unrolls and vectorizes the small
+// products of the Kalman filter without an external linear algebra library.
+template <std::size_t Rows, std::size_t Cols>
+struct Matrix
+{
+    static constexpr std::size_t rows = Rows;
+    static constexpr std::size_t cols = Cols;
+
+    std::array<double, Rows * Cols> data{};     // Row-major coefficients
+
+    double& operator()(std::size_t row, std::size_t col) { return data[row * Cols + col]; }
+    double operator()(std::size_t row, std::size_t col) const { return data[row * Cols + col]; }
+
+    // Identity matrix
+    static Matrix identity()
+    {
+        static_assert(Rows == Cols, "identity of a non-square matrix");
+        Matrix result;
+        for (std::size_t i = 0; i < Rows; i++)
+            result(i, i) = 1.0;
+        return result;
+    }
+
+    // Transposed copy
+    Matrix<Cols, Rows> transposed() const
+    {
+        Matrix<Cols, Rows> result;
+        for (std::size_t row = 0; row < Rows; row++)
+            for (std::size_t col = 0; col < Cols; col++)
+                result(col, row) = (*this)(row, col);
+        return result;
+    }
+
+    // Copy of the block of size BlockRows x BlockCols at (row, col)
+    template <std::size_t BlockRows, std::size_t BlockCols>
+    Matrix<BlockRows, BlockCols> block(std::size_t row, std::size_t col) const
+    {
+        Matrix<BlockRows, BlockCols> result;
+        for (std::size_t i = 0; i < BlockRows; i++)
+            for (std::size_t j = 0; j < BlockCols; j++)
+                result(i, j) = (*this)(row + i, col + j);
+        return result;
+    }
+
+    // Overwrite the block at (row, col)
+    template <std::size_t BlockRows, std::size_t BlockCols>
+    void setBlock(std::size_t row, std::size_t col, const Matrix<BlockRows, BlockCols>& values)
+    {
+        for (std::size_t i = 0; i < BlockRows; i++)
+            for (std::size_t j = 0; j < BlockCols; j++)
+                (*this)(row + i, col + j) = values(i, j);
+    }
+
+    Matrix& operator+=(const Matrix& other)
+    {
+        for (std::size_t i = 0; i < Rows * Cols; i++)
+            data[i] += other.data[i];
+        return *this;
+    }
+
+    Matrix& operator-=(const Matrix& other)
+    {
+        for (std::size_t i = 0; i < Rows * Cols; i++)
+            data[i] -= other.data[i];
+        return *this;
+    }
+
+    Matrix& operator*=(double scale)
+    {
+        for (double& value : data)
+            value *= scale;
+        return *this;
+    }
+};
+
+template <std::size_t Rows, std::size_t Cols>
+Matrix<Rows, Cols> operator+(Matrix<Rows, Cols> left, const Matrix<Rows, Cols>& right) { return left += right; }
+
+template <std::size_t Rows, std::size_t Cols>
+Matrix<Rows, Cols> operator-(Matrix<Rows, Cols> left, const Matrix<Rows, Cols>& right) { return left -= right; }
+
+template <std::size_t Rows, std::size_t Cols>
+Matrix<Rows, Cols> operator*(Matrix<Rows, Cols> matrix, double scale) { return matrix *= scale; }
+
+// Matrix product (i-k-j order: the inner loop runs along contiguous rows of both operands)
+template <std::size_t Rows, std::size_t Inner, std::size_t Cols>
+Matrix<Rows, Cols> operator*(const Matrix<Rows, Inner>& left, const Matrix<Inner, Cols>& right)
+{
+    Matrix<Rows, Cols> result;
+    for (std::size_t i = 0; i < Rows; i++)
+#pragma GCC unroll 16
+        for (std::size_t k = 0; k < Inner; k++)
+        {
+            const double factor = left(i, k);
+#pragma GCC unroll 16
+            for (std::size_t j = 0; j < Cols; j++)
+                result(i, j) += factor * right(k, j);
+        }
+    return result;
+}
+
+// Inverse of a symmetric positive definite matrix by Cholesky factorization;
+// false if the matrix is not positive definite
+template <std::size_t N>
+bool invertSymmetric(const Matrix<N, N>& matrix, Matrix<N, N>& inverse)
+{
+    // matrix = L L^T
+    Matrix<N, N> lower;
+    for (std::size_t j = 0; j < N; j++)
+    {
+        double diagonal = matrix(j, j);
+        for (std::size_t k = 0; k < j; k++)
+            diagonal -= lower(j, k) * lower(j, k);
+        if (!(diagonal > 0.0))
+            return false;
+        lower(j, j) = std::sqrt(diagonal);
+
+        for (std::size_t i = j + 1; i < N; i++)
+        {
+            double value = matrix(i, j);
+            for (std::size_t k = 0; k < j; k++)
+                value -= lower(i, k) * lower(j, k);
+            lower(i, j) = value / lower(j, j);
+        }
+    }
+
+    // L^-1 by forward substitution, then inverse = L^-T L^-1
+    Matrix<N, N> lower_inverse;
+    for (std::size_t j = 0; j < N; j++)
+    {
+        lower_inverse(j, j) = 1.0 / lower(j, j);
+        for (std::size_t i = j + 1; i < N; i++)
+        {
+            double value = 0.0;
+            for (std::size_t k = j; k < i; k++)
+                value -= lower(i, k) * lower_inverse(k, j);
+            lower_inverse(i, j) = value / lower(i, i);
+        }
+    }
+    inverse = lower_inverse.transposed() * lower_inverse;
+    return true;
+}
@@ -0,0 +1,59 @@
+#pragma once // Avoid multiple inclusion
+#include <array>
+#include <cstddef>
+#include "KalmanFilter.hpp"
+
+// Navigation filter tuning
+struct NavigationConfig
+{
+    double acceleration_noise = 0.1;        // White acceleration driving the velocity ((m/s^2)/sqrt(Hz))
+    double initial_velocity_sigma = 1.0;    // Initial velocity uncertainty (m/s)
+    double initial_attitude_sigma = 0.1;    // Initial attitude uncertainty (rad)
+};
+
+// IMU/GNSS error-state Kalman filter over position, velocity and attitude.
+// The nominal state is propagated with every IMU sample: the attitude quaternion integrates the
+// measured attitude rate and the position integrates the velocity (constant-velocity model, the
+// IMUs provide no acceleration). A 9-state Kalman filter tracks the covariance of the error
+// [position, velocity, attitude angle]; a GNSS position estimates that error, which is folded
+// into the nominal state and reset to zero. All storage is fixed-size, with no heap allocation.
+class NavigationFilter
+{
+    public:
+        static constexpr std::size_t states = 9;                    // Error-state size
+        using Filter = KalmanFilter<states>;
+
+        // Constructor
+        explicit NavigationFilter(const NavigationConfig& config = NavigationConfig());
+
+        // Start from a first position measurement (zero velocity, level attitude)
+        void initialize(const std::array<double, 3>& position, double position_noise);
+
+        // Forget the state (the next position initializes the filter again)
+        void reset() { initialized_ = false; }
+
+        // True once a position has initialized the filter
+        bool isInitialized() const { return initialized_; }
+
+        // Predict step: propagate over dt seconds with an attitude rate (rate_noise: standard deviation per sample)
+        void predict(const std::array<double, 3>& rate, double dt, double rate_noise);
+
+        // Update step: correct with a position measurement; false if it was rejected
+        bool update(const std::array<double, 3>& position, double position_noise);
+
+        // Estimated position, velocity and attitude (quaternion w, x, y, z)
+        const std::array<double, 3>& position() const { return position_; }
+        const std::array<double, 3>& velocity() const { return velocity_; }
+        const std::array<double, 4>& attitude() const { return attitude_; }
+
+        // Error covariance
+        const Filter::Covariance& covariance() const { return filter_.covariance(); }
+
+    private:
+        NavigationConfig config_;                       // Tuning
+        Filter filter_;                                 // Error covariance
+        std::array<double, 3> position_{};              // Nominal position
+        std::array<double, 3> velocity_{};              // Nominal velocity
+        std::array<double, 4> attitude_{1.0, 0.0, 0.0, 0.0};   // Nominal attitude quaternion
+        bool initialized_ = false;                      // A position initialized the filter
+};
@@ -0,0 +1,19 @@
+#pragma once
+#include "../sensors/Sensor.hpp"
+
+// Output data structure (timestamp, IMU, GNSS, validity)
+struct ProcessingOutput 
+{
+    Sensor::Timestamp timestamp;
+    double attitude_rate_x;
+    double attitude_rate_y;
+    double attitude_rate_z;
+    double last_pos_x;
+    double last_pos_y;
+    double last_pos_z;
+    bool valid_imu;
+    bool valid_gnss;
+    Sensor::Timestamp imu_sample_time;      // Generation time of the fused IMU data (fusion timestamp)
+    Sensor::Timestamp gnss_sample_time;     // Generation time of the GNSS sample
+    std::uint64_t gnss_sequence;            // Sequence number of the GNSS sample in its sensor
+};
@@ -6,24 +6,23 @@
 #include <atomic>
 #include <mutex>
 #include <optional>
-#include <fstream>
+#include <array>
 #include "../sensors/ImuSensor.hpp"
 #include "../sensors/GnssSensor.hpp"
 #include "../logging/Logger.hpp"
+#include "../recording/Recorder.hpp"
+#include "../scheduling/Executor.hpp"
+#include "../scheduling/PeriodicTimer.hpp"
+#include "../scheduling/DataSignal.hpp"
+#include "../metrics/LatencyHistogram.hpp"
+#include "../metrics/ComponentMetrics.hpp"
+#include "../transport/MessageBus.hpp"
+#include "ProcessingOutput.hpp"
+#include "ImuFusion.hpp"
+#include "NavigationFilter.hpp"
 
-// Output data structure (timestamp, IMU, GNSS, validity)
-struct ProcessingOutput 
-{
-    Sensor::Timestamp timestamp;
-    double attitude_rate_x;
-    double attitude_rate_y;
-    double attitude_rate_z;
-    double last_pos_x;
-    double last_pos_y;
-    double last_pos_z;
-    bool valid_imu;
-    bool valid_gnss;
-};
+// Fusion engine: IMU mean and newest GNSS position, or IMU/GNSS error-state Kalman filter
+enum class FusionEngine { Average, Kalman };
 
 class ProcessingUnit 
 {
@@ -32,7 +31,10 @@ class ProcessingUnit
         ProcessingUnit(
             std::vector<std::shared_ptr<ImuSensor>> imu_sensors, 
             std::vector<std::shared_ptr<GnssSensor>> gnss_sensors, 
-            double frequency
+            double frequency,
+            RecordingFormat recording_format = RecordingFormat::Csv,
+            const FlushPolicy& flush_policy = FlushPolicy(),
+            const std::string& data_root = "../data"
         );
 
         // Destructor (default behaviour)
@@ -47,27 +49,89 @@ class ProcessingUnit
         // Retrieve last data from sensors
         ProcessingOutput getSensorData();
 
-        // Get last output
-        ProcessingOutput getLastOutput() const { return last_output_; };
+        // Get the output topic "fusion/output": every output is published there, wait-free, and
+        // the subscribers (FDIR, ...) read it from the topic slots
+        std::shared_ptr<Topic<ProcessingOutput>> getOutputTopic() const { return output_topic_; }
+
+        // Run the processing unit on an executor instead of its own thread (set before start())
+        void setExecutor(std::shared_ptr<Executor> executor) { executor_ = std::move(executor); }
+
+        // Fuse as soon as imu_quorum IMUs have published a new sample instead of polling at the
+        // nominal frequency, which remains the minimum output rate (set before start(), 0 = periodic).
+        // Data-driven fusion always runs on its own thread, woken by the sensors.
+        void setDataDriven(std::size_t imu_quorum);
+
+        // Select the fusion engine (set before start()). With the Kalman engine the output position
+        // is the filtered one; the filter predicts on every IMU sample and updates on every GNSS sample.
+        void setFusionEngine(FusionEngine engine) { fusion_engine_ = engine; }
+
+        // Get the period error and jitter of the processing loop since the last start
+        TimingStats getTimingStats() const { return timing_.stats(); }
+
+        // Get the live counters of the processing loop since the last start (lock: output_mutex_)
+        const ComponentMetrics& getMetrics() const { return metrics_; }
+
+        // Get the directory of the recorded outputs
+        const std::string& getDataDirectory() const { return data_directory_; }
+
+        // Get the output recorder (queue depth, drops)
+        const Recorder& getRecorder() const { return *recorder_; }
+
+        // Get the sample age at fusion (generation to output) since the last start, IMU and GNSS
+        std::vector<const LatencyTracker*> getLatencyTrackers() const { return {&imu_latency_, &gnss_latency_}; }
 
     private:
         // Processing unit loop
         void run();
 
-        // Retrieve attitude rate from IMU data
-        std::array<std::optional<double>, 3> getAttitudeRate(
-            std::vector<std::array<std::optional<double>, 3>> imu_data, 
-            std::vector<std::optional<Sensor::Timestamp>> imu_timestamps
-        );
+        // Data-driven processing loop: wait for the IMU quorum (or the nominal period) and fuse
+        void runDataDriven();
+
+        // One iteration of the processing loop
+        void tick();
+
+        // Feed the IMU and GNSS samples published since the last cycle to the navigation filter, in time order
+        void runNavigation();
+
+        // Sample waiting for the navigation filter
+        struct NavigationSample
+        {
+            Sensor::Sample sample;      // Buffered sample
+            double noise;               // Sensor noise (standard deviation)
+            bool gnss;                  // Position (update) or attitude rate (predict)
+        };
 
         std::vector<std::shared_ptr<ImuSensor>> imu_sensors_;       // IMU sensors
         std::vector<std::shared_ptr<GnssSensor>> gnss_sensors_;     // GNSS sensor
         double frequency_;                                          // Processing frequency
         std::thread thread_;                                        // Simulation thread
-        bool running_;                                 // Thread control flag
+        std::atomic<bool> running_;                                 // Thread control flag
+        std::shared_ptr<Executor> executor_;                        // Optional executor (replaces thread_)
+        Executor::TaskId task_id_ = 0;                              // Task on the executor
+        ImuFusion imu_fusion_;                                      // Time-aligned IMU fusion stage
         std::mutex output_mutex_;                                   // Output mutex
-        ProcessingOutput last_output_;                              // Last processed output
+        std::shared_ptr<Topic<ProcessingOutput>> output_topic_;     // Published outputs
         std::string data_directory_;                                // Data directory path
-        std::ofstream imu_file_;                                    // IMU CSV file stream
-        std::ofstream gnss_file_;                                   // GNSS CSV file stream
+        std::unique_ptr<Recorder> recorder_;                        // Output recording (own writer thread)
+        TimingMonitor timing_;                                      // Activation period and jitter
+        LatencyTracker imu_latency_;                                // Fused IMU data age at output
+        ComponentMetrics metrics_;                                  // Ticks, outputs and output_mutex_ waits
+        LatencyTracker gnss_latency_;                               // GNSS sample age at output
+        std::shared_ptr<DataSignal> data_signal_;                   // New IMU sample notification (data-driven mode)
+        std::size_t imu_quorum_ = 0;                                // IMUs with new data triggering a fusion (0 = periodic)
+        std::uint64_t fusions_ = 0;                                 // Data-driven fusions since start
+        double latency_sum_ns_ = 0.0;                               // Sum of the sample-to-fusion latencies
+        double latency_max_ns_ = 0.0;                               // Largest sample-to-fusion latency
+        FusionEngine fusion_engine_ = FusionEngine::Average;        // Selected fusion engine
+        NavigationFilter navigation_;                               // Error-state Kalman filter (Kalman engine)
+        std::optional<Sensor::Timestamp> navigation_time_;          // Time of the filter state
+        std::array<double, 3> navigation_rate_{};                   // Last attitude rate fed to the filter
+        double navigation_rate_noise_ = 0.0;                        // Noise of that rate
+        std::vector<std::uint64_t> imu_cursors_;                    // Next IMU sample index to feed the filter
+        std::vector<std::uint64_t> gnss_cursors_;                   // Next GNSS sample index to feed the filter
+        std::vector<NavigationSample> navigation_samples_;          // New samples of the cycle, sorted by time
+        std::uint64_t predictions_ = 0;                             // Predict steps since start
+        std::uint64_t updates_ = 0;                                 // Update steps since start
+        double prediction_ns_ = 0.0;                                // Time spent in the predict steps
+        double update_ns_ = 0.0;                                    // Time spent in the update steps
 };
\ No newline at end of file
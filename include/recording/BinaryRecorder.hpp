@@ -0,0 +1,171 @@
+#pragma once // Avoid multiple inclusion
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "../sensors/Sensor.hpp"
+
+// Binary columnar recording format (one file per output stream, e.g. imu.bin, gnss.bin)
+//
+// [FileHeader]   one 4096-byte page: magic, schema, sensor names, clock origin
+// [Chunk 0]      ChunkHeader (64 bytes) followed by one column after the other:
+//                  timestamp  int64[chunk_rows]   steady clock, ns since its epoch
+//                  value_0    float64[chunk_rows]
+//                  value_1    float64[chunk_rows]
+//                  value_2    float64[chunk_rows]
+//                  valid      uint8[chunk_rows]
+//                padded to a multiple of 4096 bytes
+// [Chunk 1] ...
+//
+// Every chunk has the same size, so chunk i starts at header_size + i * chunk_size and
+// each column can be read in place from a memory-mapped file. Only the last chunk can
+// have row_count < chunk_rows. All values are little-endian.
+namespace recording
+{
+    constexpr char file_magic[8] = {'M', 'T', 'S', 'S', 'R', 'E', 'C', '1'};
+    constexpr char chunk_magic[4] = {'C', 'H', 'N', 'K'};
+    constexpr std::uint32_t format_version = 1;
+    constexpr std::size_t page_size = 4096;
+    constexpr std::size_t name_length = 32;
+    constexpr std::size_t max_sensors = 32;
+    constexpr std::size_t value_columns = 3;
+    constexpr std::size_t column_total = value_columns + 2; // timestamp, values, valid
+
+    // Column data types
+    enum class ColumnType : std::uint8_t
+    {
+        Int64 = 0,
+        Float64 = 1,
+        UInt8 = 2
+    };
+
+    // Column description
+    struct ColumnDesc
+    {
+        char name[name_length];
+        ColumnType type;
+        std::uint8_t width;     // Bytes per row
+        std::uint8_t reserved[6];
+    };
+
+    // File header, padded to one page
+    struct FileHeader
+    {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t header_size;              // Offset of the first chunk
+        std::uint32_t chunk_rows;               // Rows per chunk
+        std::uint32_t chunk_size;               // Bytes per chunk (multiple of page_size)
+        std::int64_t origin_steady_ns;          // Steady clock at the start of the recording
+        std::int64_t origin_system_ns;          // Wall clock (Unix epoch) at the same instant
+        char stream_name[name_length];          // e.g. "imu", "gnss"
+        std::uint32_t column_count;
+        std::uint32_t sensor_count;
+        ColumnDesc columns[column_total];
+        char sensor_names[max_sensors][name_length];
+    };
+    static_assert(sizeof(FileHeader) <= page_size, "FileHeader must fit in one page");
+
+    // Chunk header
+    struct ChunkHeader
+    {
+        char magic[4];
+        std::uint32_t row_count;                // Valid rows in this chunk
+        std::uint64_t chunk_index;
+        std::int64_t first_timestamp_ns;
+        std::int64_t last_timestamp_ns;
+        std::uint8_t reserved[32];
+    };
+    static_assert(sizeof(ChunkHeader) == 64, "ChunkHeader must be 64 bytes");
+
+    // Byte offset of a column inside a chunk
+    std::size_t columnOffset(std::uint32_t chunk_rows, std::size_t column);
+
+    // Total size of a chunk for a given number of rows
+    std::size_t chunkSize(std::uint32_t chunk_rows);
+}
+
+// Writes one output stream in the binary columnar format
+class BinaryRecorder
+{
+    public:
+        // Constructor: create the file and write the header
+        BinaryRecorder(
+            const std::string& path,
+            const std::string& stream_name,
+            const std::array<std::string, recording::value_columns>& value_names,
+            const std::vector<std::string>& sensor_names,
+            Sensor::Timestamp origin,
+            std::uint32_t chunk_rows = 4096
+        );
+
+        // Destructor: write the pending rows
+        ~BinaryRecorder();
+
+        BinaryRecorder(const BinaryRecorder&) = delete;
+        BinaryRecorder& operator=(const BinaryRecorder&) = delete;
+
+        // Append a row
+        void append(Sensor::Timestamp timestamp, double value_0, double value_1, double value_2, bool valid);
+
+        // Write the current (partial) chunk and flush the file
+        void flush();
+
+        // Check if the file is open
+        bool isOpen() const { return file_.is_open(); }
+
+    private:
+        // Write the current chunk at its position in the file
+        void writeChunk();
+
+        std::ofstream file_;                // Output file
+        std::uint32_t chunk_rows_;          // Rows per chunk
+        std::vector<char> chunk_;           // Current chunk (header + columns)
+        std::uint32_t rows_ = 0;            // Rows in the current chunk
+        std::uint64_t chunk_index_ = 0;     // Index of the current chunk
+};
+
+// Read-only memory-mapped view of a binary recording
+class RecordingReader
+{
+    public:
+        // Constructor: map the file (check isOpen() for errors)
+        explicit RecordingReader(const std::string& path);
+
+        // Destructor: unmap the file
+        ~RecordingReader();
+
+        RecordingReader(const RecordingReader&) = delete;
+        RecordingReader& operator=(const RecordingReader&) = delete;
+
+        // Check if the file is mapped and the header is valid
+        bool isOpen() const { return header_ != nullptr; }
+
+        // Get the file header
+        const recording::FileHeader& header() const { return *header_; }
+
+        // Number of chunks in the file
+        std::size_t chunkCount() const { return chunk_count_; }
+
+        // Get a chunk header
+        const recording::ChunkHeader& chunk(std::size_t index) const;
+
+        // Get the number of valid rows of a chunk (at most chunk_rows, whatever the chunk header says)
+        std::uint32_t rowCount(std::size_t index) const;
+
+        // Get a column of a chunk (in place, no copy)
+        const std::int64_t* timestamps(std::size_t index) const;
+        const double* values(std::size_t index, std::size_t column) const;
+        const std::uint8_t* valid(std::size_t index) const;
+
+    private:
+        // Get the start of a chunk
+        const char* chunkData(std::size_t index) const;
+
+        const char* data_ = nullptr;                        // Mapped file
+        std::size_t size_ = 0;                              // Mapped size
+        const recording::FileHeader* header_ = nullptr;     // File header (in the mapping)
+        std::size_t chunk_count_ = 0;                       // Number of complete chunks
+};
@@ -0,0 +1,66 @@
+#pragma once // Avoid multiple inclusion
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// When a CsvWriter writes its buffer to the file
+struct FlushPolicy
+{
+    std::size_t every_rows = 0;                         // Flush every N rows (0 = only when the buffer is full)
+    std::chrono::milliseconds every_interval{0};        // Flush when the oldest pending row is older than T (0 = never)
+    bool on_signal = true;                              // Flush from SIGINT/SIGTERM/SIGABRT/SIGSEGV handlers
+};
+
+// CSV file writer formatting into a caller-owned buffer with std::to_chars.
+// The buffer is written to the file with a single write() according to the flush policy,
+// when it is full, on flush() and on destruction.
+class CsvWriter
+{
+    public:
+        // Constructor: open the file and write the header line.
+        // The buffer must outlive the writer and hold at least one row (256 bytes).
+        CsvWriter(const std::string& path, const std::string& header, char* buffer, std::size_t capacity,
+                  const FlushPolicy& policy, int precision = 6);
+
+        // Destructor: flush and close the file
+        ~CsvWriter();
+
+        CsvWriter(const CsvWriter&) = delete;
+        CsvWriter& operator=(const CsvWriter&) = delete;
+
+        // Check if the file is open
+        bool isOpen() const { return fd_ >= 0; }
+
+        // Append a row: timestamp, three values and a validity flag
+        void writeRow(std::int64_t timestamp, double value_0, double value_1, double value_2, bool valid);
+
+        // Apply the time-based flush policy (call periodically)
+        void poll(std::chrono::steady_clock::time_point now);
+
+        // Write the buffer to the file
+        void flush();
+
+        // Flush all the open writers from signal handlers for SIGINT, SIGTERM, SIGABRT and SIGSEGV
+        static void installSignalHandlers();
+
+    private:
+        // Append a double with the configured precision
+        void appendDouble(double value);
+
+        // Register / unregister the writer for signal flushing
+        void registerWriter();
+        void unregisterWriter();
+
+        // Signal handler: write out pending buffers, then run the default action
+        static void onSignal(int signal);
+
+        int fd_ = -1;                                       // Output file descriptor
+        char* buffer_;                                      // Caller-owned output buffer
+        std::size_t capacity_;                              // Buffer capacity
+        std::size_t used_ = 0;                              // Bytes pending in the buffer
+        std::size_t pending_rows_ = 0;                      // Rows pending in the buffer
+        std::chrono::steady_clock::time_point first_pending_;   // Time of the oldest pending row
+        FlushPolicy policy_;                                // Flush policy
+        int precision_;                                     // Significant digits for doubles
+};
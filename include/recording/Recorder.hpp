@@ -0,0 +1,81 @@
+#pragma once // Avoid multiple inclusion
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "BinaryRecorder.hpp"
+#include "CsvWriter.hpp"
+#include "../logging/MpscQueue.hpp"
+#include "../processing/ProcessingOutput.hpp"
+
+// Output recording format
+enum class RecordingFormat
+{
+    Csv,    // imu.csv, gnss.csv (text)
+    Binary  // imu.bin, gnss.bin (columnar, see BinaryRecorder.hpp)
+};
+
+// Records the ProcessingUnit outputs from a dedicated writer thread.
+// The fusion thread only enqueues the output; formatting and file I/O happen here.
+class Recorder
+{
+    public:
+        // Constructor: create the output files in the data directory
+        Recorder(
+            const std::string& data_directory,
+            RecordingFormat format,
+            const std::vector<std::string>& imu_names,
+            const std::vector<std::string>& gnss_names,
+            const FlushPolicy& flush_policy = FlushPolicy(),
+            std::size_t queue_capacity = 1024
+        );
+
+        // Destructor: stop the writer thread
+        ~Recorder();
+
+        // Start the writer thread
+        void start();
+
+        // Stop the writer thread, writing every queued output
+        void stop();
+
+        // Enqueue an output (fusion thread). Returns false if the queue is full.
+        bool push(const ProcessingOutput& output);
+
+        // Number of outputs dropped because the queue was full
+        std::uint64_t droppedCount() const { return dropped_; }
+
+        // Outputs waiting in the queue (approximate) and queue capacity
+        std::size_t queueDepth() const { return queue_.size(); }
+        std::size_t queueCapacity() const { return queue_.capacity(); }
+
+    private:
+        // Writer thread loop
+        void run();
+
+        // Write one output to the sinks
+        void write(const ProcessingOutput& output);
+
+        // Flush the sinks
+        void flush();
+
+        RecordingFormat format_;                            // Output format
+        FlushPolicy flush_policy_;                          // Flush policy
+        std::vector<char> imu_buffer_;                      // IMU CSV output buffer
+        std::vector<char> gnss_buffer_;                     // GNSS CSV output buffer
+        std::unique_ptr<CsvWriter> imu_csv_;                // IMU CSV sink
+        std::unique_ptr<CsvWriter> gnss_csv_;               // GNSS CSV sink
+        std::unique_ptr<BinaryRecorder> imu_binary_;        // IMU binary sink
+        std::unique_ptr<BinaryRecorder> gnss_binary_;       // GNSS binary sink
+        MpscQueue<ProcessingOutput> queue_;                 // Outputs waiting to be written
+        std::thread thread_;                                // Writer thread
+        std::atomic<bool> running_{false};                  // Thread control flag
+        std::atomic<bool> idle_{false};                     // Writer waiting for outputs
+        std::mutex wake_mutex_;                             // Mutex for the writer wake-up
+        std::condition_variable wake_;                      // Writer wake-up
+        std::atomic<std::uint64_t> dropped_{0};             // Outputs dropped on overflow
+};
@@ -0,0 +1,73 @@
+#pragma once // Avoid multiple inclusion
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+class RecordingReader;
+
+// Recorded output stream read back for replay: a CSV (imu.csv, gnss.csv) or binary (imu.bin,
+// gnss.bin) recording of the ProcessingUnit. The file is memory-mapped and parsed one record at
+// a time; consumed CSV pages are released from the mapping as the replay advances, so a recording
+// of any size is streamed without being loaded into memory.
+class ReplaySource
+{
+    public:
+        // One recorded row
+        struct Record
+        {
+            std::int64_t time_ns;               // Recorded steady clock time in ns
+            std::array<double, 3> values;       // Recorded values
+            bool valid;                         // Validity flag of the row
+        };
+
+        // Constructor: map the recording (check isOpen() for errors)
+        explicit ReplaySource(const std::string& path);
+
+        // Destructor: unmap the file
+        ~ReplaySource();
+
+        ReplaySource(const ReplaySource&) = delete;
+        ReplaySource& operator=(const ReplaySource&) = delete;
+
+        // Check if the recording is mapped
+        bool isOpen() const { return csv_data_ != nullptr || binary_ != nullptr; }
+
+        // Get the recording path
+        const std::string& getPath() const { return path_; }
+
+        // Read the next record; false at the end of the recording (single reader)
+        bool next(Record& record);
+
+        // Go back to the first record
+        void rewind();
+
+        // Nominal rate in Hz from the median interval of the first records (0 if unknown)
+        double estimateFrequency(std::size_t records = 101) const;
+
+    private:
+        // Read position
+        struct Cursor
+        {
+            std::size_t offset = 0;     // CSV: byte offset of the next line
+            std::size_t chunk = 0;      // Binary: chunk of the next row
+            std::size_t row = 0;        // Binary: row of the next row in its chunk
+        };
+
+        // Read the record at a cursor and advance it
+        bool read(Cursor& cursor, Record& record) const;
+        bool readCsv(Cursor& cursor, Record& record) const;
+        bool readBinary(Cursor& cursor, Record& record) const;
+
+        // Drop the consumed CSV pages from the mapping
+        void releaseConsumed();
+
+        std::string path_;                          // Recording path
+        const char* csv_data_ = nullptr;            // Mapped CSV file
+        std::size_t csv_size_ = 0;                  // Mapped size
+        std::size_t first_row_ = 0;                 // Offset of the first data line (after the header)
+        std::size_t released_ = 0;                  // Consumed bytes already released
+        std::unique_ptr<RecordingReader> binary_;   // Binary recording (maps the file itself)
+        Cursor cursor_;                             // Next record
+};
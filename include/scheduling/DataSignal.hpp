@@ -0,0 +1,21 @@
+#pragma once // Avoid multiple inclusion
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+// Wake-up signal from data producers (sensors) to one consumer (processing unit), built on a futex.
+// Notifications are coalesced: only the first notify() after the consumer has woken up makes
+// a system call, the others only find the flag already set. The consumer never polls.
+class DataSignal
+{
+    public:
+        // Signal new data (any thread, lock-free)
+        void notify();
+
+        // Wait until notified or the timeout expires, consuming the notification (single consumer).
+        // Returns false on timeout.
+        bool waitFor(std::chrono::nanoseconds timeout);
+
+    private:
+        std::atomic<std::uint32_t> pending_{0};    // 1 when notified and not consumed yet (futex word)
+};
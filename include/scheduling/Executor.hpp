@@ -0,0 +1,28 @@
+#pragma once // Avoid multiple inclusion
+#include <cstdint>
+#include <functional>
+#include <string>
+
+// Periodic task run by an Executor
+struct PeriodicTask
+{
+    std::string name;                   // Component name (for diagnostics)
+    std::function<double()> frequency;  // Current frequency in Hz, read again after every tick
+    std::function<void()> tick;         // One iteration of the component loop
+};
+
+// Runs the periodic tasks of the components instead of one thread per component
+class Executor
+{
+    public:
+        using TaskId = std::uint64_t;
+
+        // Destructor (default behaviour)
+        virtual ~Executor() = default;
+
+        // Schedule a task; the first tick runs immediately
+        virtual TaskId add(PeriodicTask task) = 0;
+
+        // Unschedule a task; on return the task is not running and will not run again
+        virtual void remove(TaskId id) = 0;
+};
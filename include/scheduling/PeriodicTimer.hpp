@@ -0,0 +1,63 @@
+#pragma once // Avoid multiple inclusion
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include "../sensors/SeqLock.hpp"
+
+// Activation timing of a periodic component (all durations in ns)
+struct TimingStats
+{
+    double frequency = 0.0;             // Nominal frequency of the last activation in Hz
+    std::uint64_t activations = 0;      // Activations recorded
+    double mean_period_ns = 0.0;        // Mean measured period
+    double period_error_ns = 0.0;       // Mean period minus nominal period (drift)
+    double jitter_ns = 0.0;             // Standard deviation of the measured period
+    double max_error_ns = 0.0;          // Largest |measured period - nominal period|
+    std::uint64_t overruns = 0;         // Periods longer than 1.5 nominal periods
+};
+
+// Records the activation times of one component and publishes its period error and jitter.
+// record() is called by the component thread (or the executor running its ticks) only;
+// stats() can be read from any thread without blocking the writer.
+class TimingMonitor
+{
+    public:
+        // Clear the statistics (before the component starts)
+        void reset();
+
+        // Record an activation now, at the given nominal frequency
+        void record(double frequency);
+
+        // Snapshot of the statistics
+        TimingStats stats() const { return stats_.load(); }
+
+        // One-line summary for the log
+        std::string summary() const;
+
+    private:
+        std::int64_t last_ns_ = 0;      // Previous activation (0 = none yet)
+        double mean_ns_ = 0.0;          // Running mean of the period (Welford)
+        double m2_ns_ = 0.0;            // Running sum of squared deviations (Welford)
+        TimingStats current_;           // Statistics being updated
+        SeqLock<TimingStats> stats_;    // Published statistics
+};
+
+// Drift-free periodic wait on absolute deadlines: deadline(k+1) = deadline(k) + period,
+// independent of how long the work took. Missed periods are skipped keeping the phase.
+// Sub-millisecond periods spin through the last microseconds to hold rates up to 10 kHz.
+class PeriodicTimer
+{
+    public:
+        // Constructor: activations are recorded in the monitor, if any
+        explicit PeriodicTimer(TimingMonitor* monitor = nullptr) : monitor_(monitor) {}
+
+        // Start the timeline now and record the first activation (calling thread)
+        void start(double frequency);
+
+        // Sleep until the next deadline at the given frequency and record the activation
+        void wait(double frequency);
+
+    private:
+        TimingMonitor* monitor_;                            // Optional activation statistics
+        std::chrono::steady_clock::time_point deadline_;    // Last deadline
+};
@@ -0,0 +1,94 @@
+#pragma once // Avoid multiple inclusion
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "Executor.hpp"
+#include "WorkerPool.hpp"
+
+// Single-threaded executor: one reactor thread drives every registered component.
+// Task deadlines are kept in a min-heap and a single timerfd (absolute CLOCK_MONOTONIC)
+// is armed for the earliest one; an eventfd wakes the reactor on add/remove/stop.
+// The reactor waits on both through epoll, so the number of tasks does not cost file descriptors.
+// With a WorkerPool the reactor only keeps time and the due ticks run on the pool workers.
+class Reactor : public Executor
+{
+    public:
+        // Constructor: create the timer and wake-up descriptors (ticks run inline without a pool)
+        explicit Reactor(std::shared_ptr<WorkerPool> pool = nullptr);
+
+        // Destructor: stop the reactor thread and close the descriptors
+        ~Reactor() override;
+
+        Reactor(const Reactor&) = delete;
+        Reactor& operator=(const Reactor&) = delete;
+
+        // Start the reactor thread
+        void start();
+
+        // Stop the reactor thread (registered tasks are kept)
+        void stop();
+
+        // Schedule a task; the first tick runs immediately
+        TaskId add(PeriodicTask task) override;
+
+        // Unschedule a task; on return the task is not running and will not run again
+        void remove(TaskId id) override;
+
+        // Number of scheduled tasks
+        std::size_t size() const;
+
+    private:
+        // Registered task
+        struct Task
+        {
+            TaskId id;
+            PeriodicTask task;
+            std::int64_t deadline_ns;   // Next absolute deadline (steady clock)
+            bool busy = false;          // Tick in progress
+            std::atomic<bool> removed{false}; // Unscheduled, skip pending ticks
+            std::shared_ptr<Task> dispatched; // Keeps the task alive while its tick is in flight
+        };
+
+        // Heap entry: deadline and task id (removed tasks are skipped lazily)
+        struct Entry
+        {
+            std::int64_t deadline_ns;
+            TaskId id;
+            bool operator>(const Entry& other) const { return deadline_ns > other.deadline_ns; }
+        };
+
+        // Reactor loop
+        void run();
+
+        // Run one tick and reschedule the task (reactor thread or pool worker)
+        void runTick(Task* task);
+
+        // Compute the next deadline and put the task back in the heap (after its tick)
+        void reschedule(const std::shared_ptr<Task>& task);
+
+        // Wake the reactor thread
+        void wake();
+
+        // Arm the timer for the earliest deadline (lock held)
+        void armTimer();
+
+        std::shared_ptr<WorkerPool> pool_;                                  // Optional pool running the ticks
+        int epoll_fd_ = -1;                                                 // epoll instance
+        int timer_fd_ = -1;                                                 // Absolute deadline timer
+        int event_fd_ = -1;                                                 // Wake-up event
+        std::thread thread_;                                                // Reactor thread
+        std::atomic<bool> running_{false};                                  // Thread control flag
+        mutable std::mutex mutex_;                                          // Protects the tasks and the heap
+        std::condition_variable idle_;                                      // Signalled when a tick completes
+        std::unordered_map<TaskId, std::shared_ptr<Task>> tasks_;           // Registered tasks
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap_; // Deadlines
+        TaskId next_id_ = 1;                                                // Next task id
+        std::int64_t armed_deadline_ = 0;                                   // Deadline the timer is armed for (0 = disarmed)
+        std::size_t in_flight_ = 0;                                         // Ticks dispatched and not finished
+};
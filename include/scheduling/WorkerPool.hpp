@@ -0,0 +1,89 @@
+#pragma once // Avoid multiple inclusion
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed pool of worker threads with per-worker job queues and work stealing.
+// A worker runs its own newest jobs first (cache locality) and, when it runs dry,
+// steals the oldest jobs of the other workers, so the load spreads over all cores.
+class WorkerPool
+{
+    public:
+        // Constructor: start the workers (0 = one per hardware thread)
+        explicit WorkerPool(std::size_t threads = 0);
+
+        // Destructor: stop the workers (queued jobs are discarded)
+        ~WorkerPool();
+
+        WorkerPool(const WorkerPool&) = delete;
+        WorkerPool& operator=(const WorkerPool&) = delete;
+
+        // Queue a job. From a worker it goes to that worker's queue, otherwise round-robin.
+        void submit(std::function<void()> job);
+
+        // Number of worker threads
+        std::size_t size() const { return threads_.size(); }
+
+        // Preallocate every worker queue for the given number of jobs queued at once
+        void reserve(std::size_t jobs);
+
+    private:
+        // Double-ended job queue over a ring of preallocated slots that only grows, so that once
+        // warmed up queuing a job allocates nothing (a std::deque frees and reallocates its blocks)
+        class JobQueue
+        {
+            public:
+                // Constructor: preallocate capacity slots
+                explicit JobQueue(std::size_t capacity) : slots_(capacity) {}
+
+                bool empty() const { return count_ == 0; }
+
+                // Make room for capacity jobs
+                void reserve(std::size_t capacity);
+
+                // Add a job at the back
+                void pushBack(std::function<void()>&& job);
+
+                // Take the newest job (back) or the oldest one (front); the queue must not be empty
+                void popBack(std::function<void()>& job);
+                void popFront(std::function<void()>& job);
+
+            private:
+                // Double the slots, keeping the job order
+                void grow() { resize(std::max<std::size_t>(2 * slots_.size(), 1)); }
+
+                // Move the jobs to capacity slots, keeping the job order
+                void resize(std::size_t capacity);
+
+                std::vector<std::function<void()>> slots_;  // Ring of job slots
+                std::size_t first_ = 0;                     // Slot of the oldest job
+                std::size_t count_ = 0;                     // Queued jobs
+        };
+
+        // Worker job queue
+        struct alignas(64) Worker
+        {
+            std::mutex mutex;
+            JobQueue jobs{64};
+        };
+
+        // Worker loop
+        void run(std::size_t index);
+
+        // Take a job: own queue first (newest), then steal from the others (oldest)
+        bool take(std::size_t index, std::function<void()>& job);
+
+        std::vector<std::unique_ptr<Worker>> workers_;  // One queue per worker
+        std::vector<std::thread> threads_;              // Worker threads
+        std::atomic<bool> running_{true};               // Thread control flag
+        std::atomic<std::size_t> next_{0};              // Round-robin index for external submits
+        std::atomic<std::size_t> pending_{0};           // Queued jobs
+        std::atomic<std::size_t> sleepers_{0};          // Workers waiting for jobs
+        std::mutex sleep_mutex_;                        // Mutex for the sleeping workers
+        std::condition_variable wake_;                  // Wakes sleeping workers
+};
@@ -1,6 +1,5 @@
 #pragma once
-#include "Sensor.hpp"
-#include <deque>
+#include "TypedSensor.hpp"
 
 // GNSS data structure representing position
 struct GnssData 
@@ -11,30 +10,24 @@ struct GnssData
     double pos_z;
 };
 
-// GNSS Sensor class
-class GnssSensor : public Sensor
+// GNSS sensor traits: log names, default buffer depth and generation policy
+struct GnssTraits
 {
-    public:
-        // Constructor
-        GnssSensor (const std::string& name, double frequency, int buffer_size, double noise);
+    static constexpr const char* component = "[GnssSensor]";
+    static constexpr const char* kind = "GNSS";
+    static constexpr const char* topic = "gnss";
+    static constexpr std::size_t capacity = 1024;
 
-        // Start GNSS thread
-        void start() override;
-        
-        // Stop GNSS thread
-        void stop() override;
-        
-        // Enable or disbale fault injection
-        void injectFault(bool enable);
+    // Generate random GNSS data
+    static GnssData generate(Sensor::Timestamp timestamp, double noise, NoiseGenerator& generator);
 
-        // Get GNSS data
-        std::deque<GnssData> getBuffer();
+    // Replayed sample
+    static GnssData fromValues(Sensor::Timestamp timestamp, const std::array<double, 3>& values) { return {timestamp, values[0], values[1], values[2]}; }
 
-    private:
-        // GNSS sensor data generation loop
-        void run() override;
+    // Published values
+    static std::array<double, 3> values(const GnssData& sample) { return {sample.pos_x, sample.pos_y, sample.pos_z}; }
+};
 
-        // GNSS data
-        GnssData generateSample();
-        std::deque<GnssData> buffer_;   // Circular data buffer
-};
\ No newline at end of file
+// GNSS Sensor
+using GnssSensor = TypedSensor<GnssData, GnssTraits>;
+extern template class TypedSensor<GnssData, GnssTraits>;
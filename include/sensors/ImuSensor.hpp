@@ -1,6 +1,5 @@
 #pragma once
-#include "Sensor.hpp"
-#include <deque>
+#include "TypedSensor.hpp"
 
 // IMU data structure: angular velocities
 struct ImuData 
@@ -11,30 +10,24 @@ struct ImuData
     double att_rate_z;
 };
 
-// IMU Sensor Class
-class ImuSensor : public Sensor 
+// IMU sensor traits: log names, default buffer depth and generation policy
+struct ImuTraits
 {
-    public:
-        // Constructor
-        ImuSensor(const std::string& name, double frequency, int buffer_size, double noise);
-        
-        // Start IMU thread
-        void start() override;
-        
-        // Stop IMU thread
-        void stop() override;
-        
-        // Enable or disbale fault injection
-        void injectFault(bool enable);
+    static constexpr const char* component = "[ImuSensor]";
+    static constexpr const char* kind = "IMU";
+    static constexpr const char* topic = "imu";
+    static constexpr std::size_t capacity = 1024;
 
-        // Get IMU data
-        std::deque<ImuData> getBuffer();
+    // Generate random IMU data
+    static ImuData generate(Sensor::Timestamp timestamp, double noise, NoiseGenerator& generator);
 
-    private:
-        // IMU sensor data generation loop
-        void run() override;
+    // Replayed sample
+    static ImuData fromValues(Sensor::Timestamp timestamp, const std::array<double, 3>& values) { return {timestamp, values[0], values[1], values[2]}; }
 
-        // IMU data
-        ImuData generateSample();
-        std::deque<ImuData> buffer_;    // Circular data buffer
-};
\ No newline at end of file
+    // Published values
+    static std::array<double, 3> values(const ImuData& sample) { return {sample.att_rate_x, sample.att_rate_y, sample.att_rate_z}; }
+};
+
+// IMU Sensor
+using ImuSensor = TypedSensor<ImuData, ImuTraits>;
+extern template class TypedSensor<ImuData, ImuTraits>;
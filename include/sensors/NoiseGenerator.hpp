@@ -0,0 +1,41 @@
+#pragma once // Avoid multiple inclusion
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// Per-sensor Gaussian noise source, seedable and reproducible.
+// Four interleaved xoshiro256++ streams fill a block of uniforms that a branch-free Box-Muller
+// transform (polynomial log/sin/cos, no library calls) turns into standard normal values.
+// Both loops run on SIMD lanes; a sample then only reads the next value of the block.
+class NoiseGenerator
+{
+    public:
+        static constexpr std::size_t lanes = 4;             // Interleaved xoshiro256++ streams
+        static constexpr std::size_t block_size = 256;      // Normal values per refill
+
+        // Constructor
+        explicit NoiseGenerator(std::uint64_t seed = 0) { reseed(seed); }
+
+        // Restart the streams from a seed (the pending block is discarded)
+        void reseed(std::uint64_t seed);
+
+        // Next standard normal value
+        double next()
+        {
+            if (index_ == block_size)
+                refill();
+            return block_[index_++];
+        }
+
+        // Seed of a named stream derived from a master seed (stable across runs, platforms and creation order)
+        static std::uint64_t streamSeed(std::uint64_t master_seed, std::string_view name);
+
+    private:
+        // Generate the next block of normal values
+        void refill();
+
+        alignas(64) std::array<double, block_size> block_{};            // Pending normal values
+        alignas(32) std::array<std::array<std::uint64_t, lanes>, 4> state_{};   // state_[word][lane]
+        std::size_t index_ = block_size;                                // Next value of the block
+};
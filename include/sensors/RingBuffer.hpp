@@ -0,0 +1,199 @@
+#pragma once // Avoid multiple inclusion
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include "SeqLock.hpp"
+
+// Fixed-capacity single-producer ring buffer.
+// The producer thread pushes wait-free and overwrites the oldest sample when full.
+// Any number of reader threads can peek the latest sample or visit a range without taking
+// a lock and without copying the buffer: each sample is copied out of its slot and checked
+// against its sequence, so a reader lapped by the producer never sees a torn sample.
+// Capacity fixes the capacity at compile time (the slot of an index is then a modulo by a
+// constant, a mask for powers of two); 0 takes it from the constructor (a mask as well when
+// the capacity is a power of two). The slots are allocated by the buffer, or placed in
+// storage provided by the caller so that many buffers can share one preallocated slab.
+template <typename T, std::size_t Capacity = 0>
+class RingBuffer
+{
+    static_assert(std::is_trivially_copyable<T>::value, "RingBuffer requires a trivially copyable sample type");
+
+    public:
+        // Constructor: capacity is fixed for the buffer lifetime (ignored with a compile-time capacity)
+        explicit RingBuffer(std::size_t capacity = Capacity) : RingBuffer(capacity, nullptr) {}
+
+        // Constructor over caller storage of storageBytes(capacity) bytes, aligned on a cache line,
+        // that outlives the buffer (the buffer does not free it); nullptr allocates the slots
+        RingBuffer(std::size_t capacity, void* storage)
+            : capacity_(Capacity != 0 ? Capacity : (capacity > 0 ? capacity : 1)), mask_(maskOf(capacity_)),
+              owned_(storage ? nullptr : new Slot[capacity_]), slots_(storage ? place(storage, capacity_) : owned_.get()) {}
+
+        // Size of the caller storage of a buffer
+        static constexpr std::size_t storageBytes(std::size_t capacity)
+        {
+            return (Capacity != 0 ? Capacity : (capacity > 0 ? capacity : 1)) * sizeof(Slot);
+        }
+
+        RingBuffer(const RingBuffer&) = delete;
+        RingBuffer& operator=(const RingBuffer&) = delete;
+
+        // Push a new sample (producer thread only, wait-free)
+        void push(const T& sample)
+        {
+            const std::uint64_t index = head_.load(std::memory_order_relaxed);
+            Slot& slot = slots_[slotOf(index)];
+
+            // Odd sequence marks the slot as being written
+            slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            slot.value = sample;
+            slot.sequence.store(2 * index + 2, std::memory_order_release);
+
+            head_.store(index + 1, std::memory_order_release);
+        }
+
+        // Discard all the samples currently stored (safe from any thread)
+        void clear() { floor_.store(head_.load(std::memory_order_acquire), std::memory_order_release); }
+
+        // Total number of samples pushed so far (index of the next sample)
+        std::uint64_t head() const { return head_.load(std::memory_order_acquire); }
+
+        // Number of samples currently readable
+        std::size_t size() const
+        {
+            const std::uint64_t head = head_.load(std::memory_order_acquire);
+            return static_cast<std::size_t>(head - first(head));
+        }
+
+        // Index of the oldest readable sample
+        std::uint64_t tail() const { return first(head_.load(std::memory_order_acquire)); }
+
+        // Copy out the sample with the given index; false if it is not readable (overwritten or cleared)
+        bool get(std::uint64_t index, T& value) const
+        {
+            if (index < tail() || index >= head())
+                return false;
+            return read(index, value);
+        }
+
+        // Check if the buffer has no readable sample
+        bool empty() const { return size() == 0; }
+
+        // Get the buffer capacity
+        std::size_t capacity() const { return Capacity != 0 ? Capacity : capacity_; }
+
+        // Copy out the latest sample, if any
+        std::optional<T> latest() const
+        {
+            while (true)
+            {
+                const std::uint64_t head = head_.load(std::memory_order_acquire);
+                if (head == first(head))
+                    return std::nullopt;
+
+                T value;
+                if (read(head - 1, value))
+                    return value;
+            }
+        }
+
+        // Visit (oldest to newest) the samples with index in [from, head()).
+        // The callback receives (index, const T&) on a checked copy of the sample. Samples
+        // older than the readable window, or overwritten while being read, are skipped.
+        // Returns the index following the last sample visited, so it can be passed back
+        // to continue reading incrementally.
+        template <typename Visitor>
+        std::uint64_t forEachSince(std::uint64_t from, Visitor&& visitor) const
+        {
+            const std::uint64_t head = head_.load(std::memory_order_acquire);
+            std::uint64_t index = from > first(head) ? from : first(head);
+
+            for (; index < head; index++)
+            {
+                T value;
+                if (!read(index, value))
+                    continue; // Overwritten by the producer while visiting
+
+                visitor(index, value);
+            }
+            return head;
+        }
+
+        // Visit (oldest to newest) the last `count` samples, as forEachSince().
+        // Returns the number of samples visited.
+        template <typename Visitor>
+        std::size_t forEachLatest(std::size_t count, Visitor&& visitor) const
+        {
+            const std::uint64_t head = head_.load(std::memory_order_acquire);
+            const std::uint64_t from = head > count ? head - count : 0;
+            std::size_t visited = 0;
+            forEachSince(from, [&](std::uint64_t, const T& value) {
+                visitor(value);
+                visited++;
+            });
+            return visited;
+        }
+
+    private:
+        // Sample slot, padded to avoid false sharing between neighbours
+        struct alignas(cache_line_size) Slot
+        {
+            std::atomic<std::uint64_t> sequence{0}; // 2 * index + 2 when stable, odd while written
+            T value;
+        };
+
+        // Slot of a sample index
+        std::size_t slotOf(std::uint64_t index) const
+        {
+            if constexpr (Capacity != 0)
+                return static_cast<std::size_t>(index % Capacity);
+            else
+                return static_cast<std::size_t>(mask_ != 0 ? index & mask_ : index % capacity_);
+        }
+
+        // Construct the slots in caller storage
+        static Slot* place(void* storage, std::size_t capacity)
+        {
+            Slot* slots = static_cast<Slot*>(storage);
+            for (std::size_t i = 0; i < capacity; i++)
+                new (&slots[i]) Slot();
+            return slots;
+        }
+
+        // Index mask of a power of two capacity (0 otherwise)
+        static constexpr std::size_t maskOf(std::size_t capacity)
+        {
+            return capacity > 1 && (capacity & (capacity - 1)) == 0 ? capacity - 1 : 0;
+        }
+
+        // Index of the oldest readable sample for a given head
+        std::uint64_t first(std::uint64_t head) const
+        {
+            const std::uint64_t floor = floor_.load(std::memory_order_acquire);
+            const std::uint64_t oldest = head > capacity() ? head - capacity() : 0;
+            return floor > oldest ? floor : oldest;
+        }
+
+        // Read the sample at the given index; fails if it was overwritten meanwhile
+        bool read(std::uint64_t index, T& value) const
+        {
+            const Slot& slot = slots_[slotOf(index)];
+            if (slot.sequence.load(std::memory_order_acquire) != 2 * index + 2)
+                return false;
+
+            value = slot.value;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            return slot.sequence.load(std::memory_order_relaxed) == 2 * index + 2;
+        }
+
+        const std::size_t capacity_;                                // Maximum number of samples
+        const std::size_t mask_;                                    // Index mask (power of two capacity)
+        std::unique_ptr<Slot[]> owned_;                             // Sample storage allocated by the buffer
+        Slot* slots_;                                               // Sample storage
+        alignas(cache_line_size) std::atomic<std::uint64_t> head_{0};   // Written by the producer only
+        alignas(cache_line_size) std::atomic<std::uint64_t> floor_{0};  // Set by clear()
+};
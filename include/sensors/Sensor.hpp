@@ -4,18 +4,39 @@
 #include <thread>
 #include <mutex>
 #include <atomic>
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <memory>
+#include "SeqLock.hpp"
+#include "NoiseGenerator.hpp"
 #include "../logging/Logger.hpp"
+#include "../logging/MpscQueue.hpp"
+#include "../scheduling/Executor.hpp"
+#include "../scheduling/PeriodicTimer.hpp"
+#include "../scheduling/DataSignal.hpp"
+#include "../metrics/ComponentMetrics.hpp"
+#include "../transport/ShmRing.hpp"
 
-// Abstract base class for all sensors (IMU and GNSS)
+// Abstract base class for all sensors (implemented by TypedSensor for IMU and GNSS)
 class Sensor {
     public:
         // Timestamp alias using steady_clock 
         using Timestamp = std::chrono::steady_clock::time_point;
 
+        // Latest sample published by a sensor (3 axes for both IMU and GNSS)
+        struct Sample
+        {
+            Timestamp timestamp;            // Generation time
+            std::uint64_t sequence;         // Number of samples published before this one
+            std::array<double, 3> values;   // Measured values
+            bool valid;                     // False once the sensor data has been cleared
+        };
+
         // Constructor
         Sensor(const std::string& name, double frequency, int buffer_size, double noise) 
             : name_(name), frequency_(frequency), buffer_size_(buffer_size), noise_(noise), 
-            running_(false), fault_injected_(false) {}
+            running_(false), fault_injected_(false), noise_generator_(NoiseGenerator::streamSeed(0, name)) {}
 
         // Destructor (default behaviour)
         virtual ~Sensor() = default;
@@ -26,37 +47,140 @@ class Sensor {
         // Stop sensor thread (it must be overrided)
         virtual void stop() = 0;
 
+        // Enable or disable fault injection (it must be overrided)
+        virtual void injectFault(bool enable) = 0;
+
         // Get sensor name
         std::string getName() const { return name_; }
 
+        // Get sensor noise (standard deviation)
+        double getNoise() const { return noise_; }
+
         // Get sensor frequency in Hz
         double getFrequency() const { return frequency_; }
 
-        // Get the last update timestamp
-        Timestamp getLastUpdate()  
-        { 
-            std::lock_guard<std::mutex> last_update_lock(last_update_mutex_);
-            return last_update_; 
+        // Get the last update timestamp (lock-free)
+        Timestamp getLastUpdate() const { return latest_.load().timestamp; }
+
+        // Get the heartbeat: steady clock time in ns of the last published sample (0 = none, single atomic load)
+        std::int64_t getHeartbeat() const { return heartbeat_ns_.load(std::memory_order_acquire); }
+
+        // Get the latest valid sample (lock-free snapshot, no mutex)
+        std::optional<Sample> getLatest() const
+        {
+            Sample sample = latest_.load();
+            if (!sample.valid)
+                return std::nullopt;
+            return sample;
         }
         
+        // Index range of the buffered samples: [getSampleTail(), getSampleHead())
+        virtual std::uint64_t getSampleTail() const = 0;
+        virtual std::uint64_t getSampleHead() const = 0;
+
+        // Copy out one buffered sample by index; false if it is no longer buffered
+        virtual bool readSample(std::uint64_t index, Sample& sample) const = 0;
+
         // Get running status
         bool isRunning() const { return running_; }
 
         // Set the frequency of the sensor
         void setFrequency(double frequency) { frequency_ = frequency;}
 
+        // Derive the noise stream from a master seed and the sensor name (set before start();
+        // the same master seed replays the same noise, whatever the thread timing)
+        void setSeed(std::uint64_t master_seed) { noise_generator_.reseed(NoiseGenerator::streamSeed(master_seed, name_)); }
+
+        // Run the sensor on an executor instead of its own thread (set before start())
+        void setExecutor(std::shared_ptr<Executor> executor) { executor_ = std::move(executor); }
+
+        // Notify a consumer on every published sample (set before start())
+        void setDataSignal(std::shared_ptr<DataSignal> signal) { data_signal_ = std::move(signal); }
+
+        // Queue a token on a monitor queue when new samples are published, once until the monitor
+        // rearms the notification, so the monitor only visits the sensors with new samples (set before start())
+        void setSampleQueue(std::shared_ptr<MpscQueue<std::uint64_t>> queue, std::uint64_t token)
+        {
+            sample_queue_ = std::move(queue);
+            sample_token_ = token;
+            sample_queued_.store(false, std::memory_order_release);
+        }
+
+        // Rearm the sample notification (monitor thread, before reading the new samples: a sample
+        // published after the rearm queues the sensor again, one published before it is read)
+        void rearmSampleQueue() { sample_queued_.exchange(false, std::memory_order_acq_rel); }
+
+        // Get the period error and jitter of the sensor loop since the last start
+        TimingStats getTimingStats() const { return timing_.stats(); }
+
+        // Get the live counters of the sensor loop since the last reset (a restart after a fault keeps them)
+        const ComponentMetrics& getMetrics() const { return metrics_; }
+
+        // Clear the live counters (sensor stopped, e.g. before a simulation start)
+        void resetMetrics() { metrics_.reset(); }
+
+        // Get the sample buffer capacity
+        std::size_t getBufferCapacity() const { return static_cast<std::size_t>(buffer_size_); }
+
     protected:
         // Sensor data generation loop
         virtual void run() = 0;
 
-        Timestamp last_update_;
+        // One iteration of the sensor loop
+        virtual void tick() = 0;
+
+        // Publish the latest sample (sensor thread only, wait-free)
+        void publishLatest(Timestamp timestamp, const std::array<double, 3>& values)
+        {
+            latest_.store(Sample{timestamp, published_++, values, true});
+            const std::int64_t timestamp_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(timestamp.time_since_epoch()).count();
+            heartbeat_ns_.store(timestamp_ns, std::memory_order_release);
+            if (shared_ring_)
+                shared_ring_->publish(timestamp_ns, values);
+            if (data_signal_)
+                data_signal_->notify();
+
+            // Queued once until the monitor rearms (the exchange publishes the sample pushed before);
+            // a full queue is retried on the next sample
+            if (sample_queue_ && !sample_queued_.exchange(true, std::memory_order_acq_rel))
+            {
+                std::uint64_t token = sample_token_;
+                if (!sample_queue_->tryPush(std::move(token)))
+                    sample_queued_.store(false, std::memory_order_relaxed);
+            }
+        }
+
+        // Invalidate the latest sample, keeping its timestamp (sensor thread, or once it has been joined)
+        void invalidateLatest()
+        {
+            if (shared_ring_)
+                shared_ring_->clear();
+            Sample sample = latest_.load();
+            if (sample.valid)
+            {
+                sample.valid = false;
+                latest_.store(sample);
+            }
+        }
+
         std::string name_;                  // Sensor name
-        double frequency_;                  // Frequency in Hz
+        std::atomic<double> frequency_;     // Frequency in Hz
         int buffer_size_;                   // Buffer size
         double noise_;                      // Sensor noise
         std::thread thread_;                // Simulation thread
-        bool running_;                      // Thread control flag
-        bool fault_injected_;               // injection fault simulation flag
-        std::mutex buffer_mutex_;           // Mutex for thread-safe buffer access
-        std::mutex last_update_mutex_;      // Mutex for thread-safe last update access
+        std::shared_ptr<Executor> executor_;    // Optional executor (replaces thread_)
+        Executor::TaskId task_id_ = 0;      // Task on the executor
+        std::atomic<bool> running_;         // Thread control flag
+        std::atomic<bool> fault_injected_;  // injection fault simulation flag
+        SeqLock<Sample> latest_;            // Latest published sample
+        std::uint64_t published_ = 0;       // Number of samples published (sensor thread only)
+        std::atomic<std::int64_t> heartbeat_ns_{0};    // Time of the last published sample
+        TimingMonitor timing_;              // Activation period and jitter
+        std::shared_ptr<DataSignal> data_signal_;   // Optional new-sample notification
+        std::shared_ptr<MpscQueue<std::uint64_t>> sample_queue_;    // Optional monitor queue of the sensors with new samples
+        std::uint64_t sample_token_ = 0;                // Token queued on sample_queue_
+        std::atomic<bool> sample_queued_{false};        // Token queued and not rearmed yet
+        std::unique_ptr<ShmRingWriter> shared_ring_;  // Optional shared memory copy of the samples
+        NoiseGenerator noise_generator_;    // Gaussian noise stream of this sensor (sensor thread only)
+        ComponentMetrics metrics_;          // Ticks, samples produced and dropped (sensor thread only)
 };
\ No newline at end of file
@@ -0,0 +1,111 @@
+#pragma once // Avoid multiple inclusion
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+// Sensor types of a suite
+enum class SensorKind { Imu, Gnss };
+
+// Group of identical sensors, named <name>1 to <name><count>. The group name is also the FDIR
+// redundancy group of its sensors.
+struct SensorGroup
+{
+    SensorKind kind;            // Sensor type
+    std::string name;           // Group name (prefix of the sensor names)
+    std::size_t count;          // Number of sensors
+    double frequency;           // Frequency in Hz
+    double noise;               // Noise standard deviation
+    std::size_t depth = 0;      // Sample buffer depth (0 = default of the sensor type)
+};
+
+// Read a sensor suite file: one group per line, "<imu|gnss> <name> <count> <frequency> <noise> [depth]",
+// '#' starts a comment. Returns false with a message naming the faulty line on error.
+bool loadSensorGroups(const std::string& path, std::vector<SensorGroup>& groups, std::string& error);
+
+// Check that the sensor names are unique and the counts, frequencies and noises valid
+bool validateSensorGroups(const std::vector<SensorGroup>& groups, std::string& error);
+
+// Number of sensors of a kind in a suite
+std::size_t countSensors(const std::vector<SensorGroup>& groups, SensorKind kind);
+
+// Sensors of one group built in bulk: the sensor objects lie in one contiguous array and their
+// sample buffers in one preallocated slab, so a group costs two allocations whatever its size
+// and its sensors are walked sequentially in memory by the readers.
+template <typename SensorT>
+class SensorBlock
+{
+    public:
+        // Constructor: build the sensors of the group. If an allocation throws part way, the
+        // sensors already built and both slabs are released before the exception propagates
+        // (the destructor does not run for a partly built block).
+        explicit SensorBlock(const SensorGroup& group)
+            : count_(group.count), depth_(group.depth != 0 ? group.depth : SensorT::default_depth),
+              buffer_bytes_(SensorT::bufferBytes(depth_))
+        {
+            std::size_t built = 0;
+            try
+            {
+                buffers_ = static_cast<char*>(::operator new(buffer_bytes_ * count_, std::align_val_t(cache_line_size)));
+                sensors_ = static_cast<SensorT*>(::operator new(sizeof(SensorT) * count_, std::align_val_t(alignof(SensorT))));
+                for (; built < count_; built++)
+                    new (&sensors_[built]) SensorT(group.name + std::to_string(built + 1), group.frequency, group.noise, depth_, buffers_ + built * buffer_bytes_);
+            }
+            catch (...)
+            {
+                release(built);
+                throw;
+            }
+        }
+
+        // Destructor: destroy the sensors (they must be stopped), then their buffers
+        ~SensorBlock() { release(count_); }
+
+        SensorBlock(const SensorBlock&) = delete;
+        SensorBlock& operator=(const SensorBlock&) = delete;
+
+        // Number of sensors
+        std::size_t size() const { return count_; }
+
+        // Sensor of the block
+        SensorT& operator[](std::size_t index) { return sensors_[index]; }
+
+    private:
+        static constexpr std::size_t cache_line_size = 64;
+
+        // Destroy the first built sensors in reverse order, then free the slabs (either may be nullptr)
+        void release(std::size_t built)
+        {
+            for (std::size_t i = built; i > 0; i--)
+                sensors_[i - 1].~SensorT();
+            if (sensors_)
+                ::operator delete(sensors_, std::align_val_t(alignof(SensorT)));
+            if (buffers_)
+                ::operator delete(buffers_, std::align_val_t(cache_line_size));
+        }
+
+        const std::size_t count_;           // Number of sensors
+        const std::size_t depth_;           // Sample buffer depth
+        const std::size_t buffer_bytes_;    // Storage of one sample buffer
+        SensorT* sensors_ = nullptr;        // Sensor array
+        char* buffers_ = nullptr;           // Sample buffer slab
+};
+
+// Create the sensors of a kind, in suite order, one block per group. Every sensor shares the
+// ownership of its block, so the block lives as long as any of its sensors is referenced.
+template <typename SensorT>
+std::vector<std::shared_ptr<SensorT>> makeSensors(const std::vector<SensorGroup>& groups, SensorKind kind)
+{
+    std::vector<std::shared_ptr<SensorT>> sensors;
+    sensors.reserve(countSensors(groups, kind));
+    for (const SensorGroup& group : groups)
+    {
+        if (group.kind != kind || group.count == 0)
+            continue;
+        auto block = std::make_shared<SensorBlock<SensorT>>(group);
+        for (std::size_t i = 0; i < block->size(); i++)
+            sensors.push_back(std::shared_ptr<SensorT>(block, &(*block)[i]));
+    }
+    return sensors;
+}
@@ -0,0 +1,57 @@
+#pragma once // Avoid multiple inclusion
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// Size of a cache line, used to keep producer and reader state apart
+constexpr std::size_t cache_line_size = 64;
+
+// Single-writer sequence lock holding one value.
+// The writer publishes wait-free; readers never block the writer and retry
+// when they catch a write in progress (odd sequence or sequence changed).
+template <typename T>
+class alignas(cache_line_size) SeqLock
+{
+    static_assert(std::is_trivially_copyable<T>::value, "SeqLock requires a trivially copyable value type");
+
+    public:
+        // Constructor: start from a default value
+        SeqLock() : value_() {}
+
+        SeqLock(const SeqLock&) = delete;
+        SeqLock& operator=(const SeqLock&) = delete;
+
+        // Publish a new value (writer thread only, wait-free)
+        void store(const T& value)
+        {
+            const std::uint64_t sequence = sequence_.load(std::memory_order_relaxed);
+            sequence_.store(sequence + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            value_ = value;
+            sequence_.store(sequence + 2, std::memory_order_release);
+        }
+
+        // Take a consistent snapshot of the value
+        T load() const
+        {
+            while (true)
+            {
+                const std::uint64_t before = sequence_.load(std::memory_order_acquire);
+                if (before & 1)
+                    continue; // Write in progress
+
+                T value = value_;
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (sequence_.load(std::memory_order_relaxed) == before)
+                    return value;
+            }
+        }
+
+        // Number of completed writes
+        std::uint64_t version() const { return sequence_.load(std::memory_order_acquire) / 2; }
+
+    private:
+        std::atomic<std::uint64_t> sequence_{0};   // Even when stable, odd while written
+        T value_;                                  // Published value
+};
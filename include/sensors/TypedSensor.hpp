@@ -0,0 +1,227 @@
+#pragma once // Avoid multiple inclusion
+#include <algorithm>
+#include <string>
+#include "Sensor.hpp"
+#include "RingBuffer.hpp"
+#include "../recording/ReplaySource.hpp"
+#include "../transport/MessageBus.hpp"
+
+// Sensor producing samples of type SampleT. Everything specific to a sensor type is resolved at
+// compile time from Traits:
+//   static constexpr const char* component;                       // Log prefix, e.g. "[ImuSensor]"
+//   static constexpr const char* kind;                            // Name in messages, e.g. "IMU"
+//   static constexpr const char* topic;                           // Bus topic prefix, e.g. "imu"
+//   static constexpr std::size_t capacity;                        // Default sample buffer depth
+//   static SampleT generate(Sensor::Timestamp, double noise, NoiseGenerator&);    // Generation policy
+//   static std::array<double, 3> values(const SampleT&);          // Published values
+//   static SampleT fromValues(Sensor::Timestamp, const std::array<double, 3>&);   // Replayed sample
+// The loop and the sample path (generate, push, publish) make no virtual call: run() and tick()
+// are final and call the traits directly. The Sensor interface is what generic consumers use.
+// A new sensor type is a sample struct, a traits struct and an explicit instantiation.
+template <typename SampleT, typename Traits>
+class TypedSensor : public Sensor
+{
+    public:
+        using SampleType = SampleT;
+        using Buffer = RingBuffer<SampleT>;
+        static constexpr std::size_t default_depth = Traits::capacity;
+
+        // Constructor: the sample buffer holds depth samples (a power of two keeps the index a mask),
+        // in buffer_storage of bufferBytes(depth) bytes if given (see SensorBlock), else allocated
+        TypedSensor(const std::string& name, double frequency, double noise,
+                    std::size_t depth = Traits::capacity, void* buffer_storage = nullptr)
+            : Sensor(name, frequency, static_cast<int>(depth), noise),
+              buffer_(depth, buffer_storage),
+              topic_(std::make_shared<Topic<SampleT>>(std::string(Traits::topic) + "/" + name, buffer_)) {}
+
+        // Size of the external storage of a sample buffer
+        static constexpr std::size_t bufferBytes(std::size_t depth) { return Buffer::storageBytes(depth); }
+
+        // Start the sensor thread
+        void start() override
+        {
+            Logger::log(Logger::Level::Info, std::string(Traits::component) + " Starting " + Traits::kind + " sensor: " + name_);
+            running_ = true;
+            timing_.reset();
+
+            // Replay from the first record, always on a dedicated thread (the timing comes from the recording)
+            if (replay_)
+            {
+                replay_->rewind();
+                thread_ = std::thread(&TypedSensor::runReplay, this);
+            }
+            // Run on the executor if one is set, otherwise on a dedicated thread
+            else if (executor_)
+                task_id_ = executor_->add({name_, [this] { return frequency_.load(); }, [this] { timing_.record(frequency_); tick(); }});
+            else
+                thread_ = std::thread(&TypedSensor::run, this);
+        }
+
+        // Stop the sensor thread
+        void stop() override
+        {
+            Logger::log(Logger::Level::Info, std::string(Traits::component) + " Stopping " + Traits::kind + " sensor: " + name_);
+            running_ = false;
+
+            // Unschedule from the executor
+            if (executor_ && task_id_ != 0)
+            {
+                executor_->remove(task_id_);
+                task_id_ = 0;
+            }
+
+            // Wait for thread to finish
+            if (thread_.joinable())
+                thread_.join();
+
+            // Report the measured rate and jitter
+            Logger::log(Logger::Level::Info, std::string(Traits::component) + " Timing of " + Traits::kind + " sensor " + name_ + ": " + timing_.summary());
+
+            // Clear the buffer
+            buffer_.clear();
+            invalidateLatest();
+        }
+
+        // Enable or disable fault injection
+        void injectFault(bool enable) override
+        {
+            Logger::log(Logger::Level::Info, std::string(Traits::component) + " Fault injection " + (enable ? "enabled" : "disabled") + " for " + Traits::kind + " sensor: " + name_);
+            fault_injected_ = enable;
+
+            // Clear the buffer if fault injection is enabled
+            if (enable)
+                buffer_.clear();
+        }
+
+        // Replay a recording instead of generating samples (set before start()). The recorded
+        // timing is scaled by 1 / speed; speed 0 publishes the samples as fast as possible.
+        void setReplay(std::shared_ptr<ReplaySource> source, double speed)
+        {
+            replay_ = std::move(source);
+            replay_speed_ = speed;
+        }
+
+        // Also publish the samples into the shared memory ring "/<ring_name>" for other processes
+        // (set before start(); false if the region cannot be created)
+        bool shareSamples(const std::string& ring_name)
+        {
+            auto ring = std::make_unique<ShmRingWriter>(ring_name, name_, Traits::kind, buffer_.capacity(), frequency_);
+            if (!ring->isOpen())
+            {
+                Logger::log(Logger::Level::Error, std::string(Traits::component) + " Cannot create the shared memory ring /" + ring_name);
+                return false;
+            }
+            shared_ring_ = std::move(ring);
+            return true;
+        }
+
+        // Get the sample buffer (read in place, no copy)
+        const Buffer& getBuffer() const { return buffer_; }
+
+        // Get the bus topic "<topic>/<name>": a view over the sample buffer, so publishing on the
+        // bus adds nothing to the sample path
+        std::shared_ptr<Topic<SampleT>> getTopic() const { return topic_; }
+
+        // Index range of the buffered samples
+        std::uint64_t getSampleTail() const override { return buffer_.tail(); }
+        std::uint64_t getSampleHead() const override { return buffer_.head(); }
+
+        // Copy out one buffered sample by index
+        bool readSample(std::uint64_t index, Sample& sample) const override
+        {
+            SampleT data;
+            if (!buffer_.get(index, data))
+                return false;
+
+            sample = Sample{data.timestamp, index, Traits::values(data), true};
+            return true;
+        }
+
+    private:
+        // Sensor data generation loop
+        void run() final
+        {
+            // Absolute deadlines: the work time does not shift the next period
+            PeriodicTimer timer(&timing_);
+            timer.start(frequency_);
+            while (running_)
+            {
+                tick();
+                timer.wait(frequency_);
+            }
+        }
+
+        // One iteration of the sensor loop
+        void tick() final
+        {
+            // Check if fault injection is enabled
+            const auto start = std::chrono::steady_clock::now();
+            if (!fault_injected_)
+            {
+                const SampleT sample = Traits::generate(start, noise_, noise_generator_);
+
+                // Wait-free push, the oldest sample is overwritten when full
+                buffer_.push(sample);
+
+                // Publish the latest sample for lock-free readers
+                publishLatest(sample.timestamp, Traits::values(sample));
+                metrics_.addProduced();
+            }
+            else
+            {
+                // Faulty sensor: readers must not see the last sample anymore
+                invalidateLatest();
+                metrics_.addDropped();
+            }
+            metrics_.recordTick(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+        }
+
+        // Replay loop: publish the recorded samples at their recorded time offsets scaled by the speed
+        void runReplay()
+        {
+            using namespace std::chrono;
+            const auto start = steady_clock::now();
+            std::int64_t first_ns = 0;
+            std::uint64_t replayed = 0;
+            ReplaySource::Record record;
+            while (running_ && replay_->next(record))
+            {
+                if (replayed++ == 0)
+                    first_ns = record.time_ns;
+
+                // Wait for the scaled offset, in short slices so that stop() is not held by a long gap
+                if (replay_speed_ > 0.0)
+                {
+                    const auto due = start + duration_cast<steady_clock::duration>(
+                        duration<double, std::nano>(static_cast<double>(record.time_ns - first_ns) / replay_speed_));
+                    while (running_ && steady_clock::now() < due)
+                        std::this_thread::sleep_until(std::min(due, steady_clock::now() + milliseconds(100)));
+                    if (!running_)
+                        break;
+                }
+
+                // Invalid recorded rows (and injected faults) hide the last sample, like a faulty sensor
+                const auto start = steady_clock::now();
+                if (record.valid && !fault_injected_)
+                {
+                    const SampleT sample = Traits::fromValues(start, record.values);
+                    buffer_.push(sample);
+                    publishLatest(sample.timestamp, record.values);
+                    metrics_.addProduced();
+                }
+                else
+                {
+                    invalidateLatest();
+                    metrics_.addDropped();
+                }
+                metrics_.recordTick(duration_cast<nanoseconds>(steady_clock::now() - start).count());
+            }
+            Logger::log(Logger::Level::Info, std::string(Traits::component) + " Replay of " + Traits::kind + " sensor " + name_ +
+                (running_ ? " finished: " : " stopped: ") + std::to_string(replayed) + " records from " + replay_->getPath());
+        }
+
+        Buffer buffer_;                         // Circular data buffer
+        std::shared_ptr<Topic<SampleT>> topic_; // Bus topic over buffer_
+        std::shared_ptr<ReplaySource> replay_;  // Recording replayed instead of generated samples
+        double replay_speed_ = 1.0;             // Replay speed factor (0 = as fast as possible)
+};
@@ -0,0 +1,49 @@
+#pragma once // Avoid multiple inclusion
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Simulator.hpp"
+
+// Execution mode: one thread per component, a single reactor thread driving all of them,
+// or a reactor dispatching the ticks to a work-stealing pool with one worker per core
+enum class ExecutionMode { ThreadPerComponent, Reactor, WorkerPool };
+
+// Fault injected during a scripted run
+struct FaultEvent
+{
+    double start_s;         // Injection start, in seconds from the simulation start
+    double end_s;           // Injection end (negative = until the end of the run)
+    std::string target;     // "imu", "gnss" or a sensor name
+};
+
+// Settings of a simulation run. The interactive mode uses the defaults of main.cpp; a headless
+// run takes them from the command line and scenario files.
+struct Scenario
+{
+    double duration_s = 10.0;                                   // Headless run duration
+    std::uint64_t seed = 0;                                     // Master noise seed (0 = random)
+    std::string sensor_config = "../config/sensors.conf";       // Sensor suite file
+    ExecutionMode execution_mode = ExecutionMode::ThreadPerComponent;
+    FusionEngine fusion_engine = FusionEngine::Average;
+    RecordingFormat recording_format = RecordingFormat::Csv;    // Output sink format
+    std::string data_directory = "../data";                     // Output sink directory
+    std::string log_directory = "../log";                       // Log file directory
+    bool console = true;                                        // Echo the log to the console
+    std::string metrics_file = "../metrics/metrics.prom";       // Metrics snapshot ("" = off)
+    std::string shared_memory;                                  // Prefix of the shared memory rings ("" = off)
+    std::vector<FaultEvent> faults;                             // Fault timeline
+};
+
+// Read a scenario file: one setting per line, "<key> <value...>", '#' starts a comment.
+// Keys: duration <s>, seed <n>, config <file>, mode <thread|reactor|pool>, fusion <average|kalman>,
+// format <csv|binary>, data <dir>, log <dir>, console <on|off>, metrics <file|off>, shm <prefix|off>,
+// fault <start s> <end s|end> <imu|gnss|sensor name>. Returns false with a message on error.
+bool loadScenario(const std::string& path, Scenario& scenario, std::string& error);
+
+// Apply the command line: "--<key> <value>" for every scenario key (a fault is "--fault start:end:target"),
+// "--scenario <file>" loads a file at that point, so later arguments override it.
+bool parseScenarioArguments(int argc, char** argv, Scenario& scenario, std::string& error);
+
+// Run the scenario: start the simulation, play the fault timeline, stop after the duration.
+// Returns as soon as the simulation is stopped, without any settle delay.
+void runScenario(Simulator& simulator, const Scenario& scenario);
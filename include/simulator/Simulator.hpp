@@ -4,6 +4,8 @@
 #include "../processing/ProcessingUnit.hpp"
 #include "../fdir/Fdir.hpp"
 #include "../logging/Logger.hpp"
+#include "../metrics/MetricsRegistry.hpp"
+#include "../transport/MessageBus.hpp"
 
 // Simulator class
 class Simulator 
@@ -30,14 +32,41 @@ class Simulator
         // GNSS sensors fault injection
         void injectGnssFaults(bool enable);
 
+        // Fault injection by target: "imu" or "gnss" (every sensor of the kind, as above; clearing the
+        // IMU fault also restarts the IMUs while the simulation runs) or a sensor name (its samples are
+        // invalidated). Returns false if no sensor matches.
+        bool injectFault(const std::string& target, bool enable);
+
+        // Log the p50/p99/p99.9 latencies of the processing unit and FDIR since the last start
+        void logLatencies() const;
+
+        // Summary of the last run (or of the running one): throughput, drops, latencies and FDIR detections
+        std::string summary() const;
+
+        // Snapshot of the runtime metrics of every component (Prometheus text format)
+        std::string metricsSnapshot() const { return metrics_.prometheus(); }
+
+        // Get the message bus: imu/<name> and gnss/<name> (sensor samples), fusion/output (processing
+        // unit outputs) and fdir/alarms (FDIR reports), for new consumers to subscribe to
+        const MessageBus& getBus() const { return bus_; }
+
+        // Write the metrics snapshot to a file every interval while the simulation runs (set before start(), "" = off)
+        void setMetricsExport(const std::string& path, std::chrono::milliseconds interval);
+
     private:
-        void run();
+        // Start every component (lock held)
+        void startComponents();
         std::vector<std::shared_ptr<ImuSensor>> imu_sensors_;   // Vector of IMU sensors
         std::vector<std::shared_ptr<GnssSensor>> gnss_sensors_; // Vector of GNSS sensors
         std::unordered_map<std::string, double> gnss_freq_;     // Map of GNSS sensor frequencies
         std::shared_ptr<ProcessingUnit> processing_unit_;       // Processing unit for data processing
         std::shared_ptr<Fdir> fdir_;                            // Fault detection, isolation, and recovery
-        std::thread simulation_thread_;                         // Thread for running the simulation
         bool running_;                             // Flag to control the simulation state
         std::mutex simulation_mutex_;                           // Mutex for thread-safe access to simulation state
+        MessageBus bus_;                                        // Topics of the components
+        MetricsRegistry metrics_;                               // Runtime metrics of the components
+        std::string metrics_path_;                              // Metrics snapshot file ("" = none)
+        std::chrono::milliseconds metrics_interval_{1000};      // Metrics snapshot interval
+        std::chrono::steady_clock::time_point started_at_;      // Start of the last run
+        std::chrono::steady_clock::time_point stopped_at_;      // End of the last run
 };
\ No newline at end of file
@@ -0,0 +1,231 @@
+#pragma once // Avoid multiple inclusion
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+#include "../sensors/RingBuffer.hpp"
+#include "../logging/Logger.hpp"
+
+// State of one subscriber as seen by the bus
+struct SubscriberStats
+{
+    std::string topic;          // Topic name
+    std::string subscriber;     // Subscriber name
+    std::uint64_t lag;          // Messages published but not read yet
+    std::uint64_t missed;       // Messages overwritten before the subscriber read them
+};
+
+// Subscriber cursor and counters. They are written by the subscriber thread only and read by
+// the bus, so reporting a slow subscriber never involves the publisher.
+class SubscriptionBase
+{
+    public:
+        // Constructor: the subscriber reads from the given message index on
+        SubscriptionBase(const std::string& subscriber, std::uint64_t cursor) : subscriber_(subscriber), cursor_(cursor) {}
+
+        virtual ~SubscriptionBase() = default;
+
+        // Get the subscriber name
+        const std::string& getSubscriber() const { return subscriber_; }
+
+        // Index of the next message to read
+        std::uint64_t getCursor() const { return cursor_.load(std::memory_order_acquire); }
+
+        // Messages overwritten before being read, since the subscription
+        std::uint64_t getMissed() const { return missed_.load(std::memory_order_relaxed); }
+
+    protected:
+        // Count the messages overwritten before a poll, warning once when the subscriber falls behind
+        void reportMissed(const std::string& topic, std::uint64_t missed);
+
+        std::string subscriber_;                // Subscriber name
+        std::atomic<std::uint64_t> cursor_;     // Next message index (subscriber thread only)
+        std::atomic<std::uint64_t> missed_{0};  // Messages overwritten before being read
+        bool lagging_ = false;                  // Last poll missed messages (subscriber thread only)
+};
+
+template <typename T>
+class Topic;
+
+// Subscription to a topic. Each subscriber has its own cursor into the topic slots and reads the
+// messages from the slots; it never blocks the publisher. A subscriber more than the topic capacity
+// behind loses the oldest messages, which are counted and reported instead.
+template <typename T>
+class Subscription : public SubscriptionBase
+{
+    public:
+        // Constructor: read the messages published from now on
+        explicit Subscription(std::shared_ptr<const Topic<T>> topic, const std::string& subscriber)
+            : SubscriptionBase(subscriber, topic->getBuffer().head()), topic_(std::move(topic)) {}
+
+        // Visit (oldest to newest) the messages published since the last poll: visitor(const T&).
+        // Subscriber thread only. As with the ring buffer, each message is copied out of its slot
+        // and checked, so a message overwritten while being read is skipped and counted as missed.
+        // Returns the number of messages visited.
+        template <typename Visitor>
+        std::size_t poll(Visitor&& visitor)
+        {
+            const RingBuffer<T>& buffer = topic_->getBuffer();
+            const std::uint64_t cursor = cursor_.load(std::memory_order_relaxed);
+            const std::uint64_t from = std::max(cursor, buffer.tail());
+            std::size_t visited = 0;
+            const std::uint64_t head = buffer.forEachSince(from, [&](std::uint64_t, const T& message) {
+                visitor(message);
+                visited++;
+            });
+
+            // Lapped by the publisher: the messages that left the window before the visit, and those
+            // overwritten while visiting (the ones withdrawn by a clear() are not missed)
+            const std::uint64_t capacity = buffer.capacity();
+            const std::uint64_t oldest = std::min(head > capacity ? head - capacity : 0, from);
+            const std::uint64_t overwritten = (oldest > cursor ? oldest - cursor : 0) + (head - from - visited);
+            reportMissed(topic_->getName(), overwritten);
+            cursor_.store(std::max(head, cursor), std::memory_order_release);
+            return visited;
+        }
+
+        // Copy out the latest message, if any, without moving the cursor
+        std::optional<T> latest() const { return topic_->getBuffer().latest(); }
+
+        // Skip the messages not read yet (e.g. when the subscriber restarts)
+        void skip() { cursor_.store(topic_->getBuffer().head(), std::memory_order_release); }
+
+        // Get the topic
+        const Topic<T>& getTopic() const { return *topic_; }
+
+    private:
+        std::shared_ptr<const Topic<T>> topic_;     // Subscribed topic
+};
+
+// Named topic, independent of its message type
+class TopicBase : public std::enable_shared_from_this<TopicBase>
+{
+    public:
+        // Constructor
+        explicit TopicBase(const std::string& name) : name_(name) {}
+
+        virtual ~TopicBase() = default;
+
+        TopicBase(const TopicBase&) = delete;
+        TopicBase& operator=(const TopicBase&) = delete;
+
+        // Get the topic name
+        const std::string& getName() const { return name_; }
+
+        // Messages published so far
+        virtual std::uint64_t getPublished() const = 0;
+
+        // Number of preallocated message slots
+        virtual std::size_t getCapacity() const = 0;
+
+        // State of the live subscribers
+        std::vector<SubscriberStats> getSubscribers() const;
+
+    protected:
+        // Track a new subscriber (subscription time only, never on the publish path)
+        void attach(const std::shared_ptr<const SubscriptionBase>& subscription) const;
+
+    private:
+        std::string name_;                                                  // Topic name
+        mutable std::mutex subscribers_mutex_;                              // Protects the subscriber list
+        mutable std::vector<std::weak_ptr<const SubscriptionBase>> subscribers_;    // Live subscribers
+};
+
+// Topic carrying messages of type T in preallocated slots: the ring buffer of the sensors (one
+// sequence counter per slot, wait-free publisher, any number of lock-free readers). A topic either
+// owns its slots and is published with publish(), or is a view over the buffer its producer already
+// pushes into (the sensors), which costs the producer nothing. One publisher thread per topic.
+template <typename T>
+class Topic : public TopicBase
+{
+    public:
+        using Buffer = RingBuffer<T>;
+
+        // Constructor: topic with its own capacity message slots
+        Topic(const std::string& name, std::size_t capacity)
+            : TopicBase(name), owned_(std::make_unique<Buffer>(capacity)), buffer_(owned_.get()) {}
+
+        // Constructor: view over the buffer of the producer, which must outlive the topic and its
+        // subscriptions (publish() is not available)
+        Topic(const std::string& name, const Buffer& buffer) : TopicBase(name), buffer_(&buffer) {}
+
+        // Publish a message (publisher thread only, wait-free; topics owning their slots only)
+        void publish(const T& message) { owned_->push(message); }
+
+        // Subscribe: the subscriber reads the messages published from now on
+        std::shared_ptr<Subscription<T>> subscribe(const std::string& subscriber) const
+        {
+            auto topic = std::static_pointer_cast<const Topic<T>>(shared_from_this());
+            auto subscription = std::make_shared<Subscription<T>>(std::move(topic), subscriber);
+            attach(subscription);
+            return subscription;
+        }
+
+        // Get the message slots
+        const Buffer& getBuffer() const { return *buffer_; }
+
+        // Messages published so far
+        std::uint64_t getPublished() const override { return buffer_->head(); }
+
+        // Number of preallocated message slots
+        std::size_t getCapacity() const override { return buffer_->capacity(); }
+
+    private:
+        std::unique_ptr<Buffer> owned_;     // Slots owned by the topic (nullptr for a view)
+        const Buffer* buffer_;              // Message slots
+};
+
+// In-process registry of the topics by name, e.g. imu/<sensor>, gnss/<sensor>, fusion/output and
+// fdir/alarms. The producers create and own their topics and register them once; consumers look
+// them up and subscribe. The registry lock is taken at registration and lookup only, never by a
+// publisher or by a subscriber reading messages.
+class MessageBus
+{
+    public:
+        // Register a topic under its name (false if the name is taken)
+        bool add(std::shared_ptr<TopicBase> topic);
+
+        // Find a topic by name (nullptr if missing or carrying another message type)
+        template <typename T>
+        std::shared_ptr<Topic<T>> find(const std::string& name) const
+        {
+            std::shared_ptr<TopicBase> topic;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                auto it = topics_.find(name);
+                if (it != topics_.end())
+                    topic = it->second;
+            }
+            auto typed = std::dynamic_pointer_cast<Topic<T>>(topic);
+            if (topic && !typed)
+                Logger::log(Logger::Level::Error, "[MessageBus] Topic " + name + " carries another message type");
+            return typed;
+        }
+
+        // Subscribe to a topic by name (nullptr if missing or carrying another message type)
+        template <typename T>
+        std::shared_ptr<Subscription<T>> subscribe(const std::string& name, const std::string& subscriber) const
+        {
+            auto topic = find<T>(name);
+            return topic ? topic->subscribe(subscriber) : nullptr;
+        }
+
+        // Names of the registered topics
+        std::vector<std::string> getTopics() const;
+
+        // State of the subscribers of every topic
+        std::vector<SubscriberStats> getSubscribers() const;
+
+        // Topic and subscriber metrics in the Prometheus text format
+        std::string prometheus() const;
+
+    private:
+        mutable std::mutex mutex_;                                  // Protects the registry
+        std::map<std::string, std::shared_ptr<TopicBase>> topics_;  // Topics by name
+};
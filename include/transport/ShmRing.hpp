@@ -0,0 +1,172 @@
+#pragma once // Avoid multiple inclusion
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+// Shared memory layout of a sensor ring, version 1. One writer process creates the region with
+// shm_open() and publishes into it; any number of processes map it read-only and read the samples
+// in place. Integers are in host byte order.
+//
+//   offset 0      ShmRingHeader   192 bytes: description (first two cache lines), indexes (third)
+//   offset 192    ShmSlot[capacity]   64 bytes each, capacity a power of two
+//
+// Sample i lives in slot i & (capacity - 1). The slot sequence is odd while the writer fills it and
+// 2 * i + 2 once it holds sample i: a reader keeps a copy of the slot only if the sequence was
+// 2 * i + 2 both before and after copying it. head counts the samples published; the samples below
+// floor were withdrawn (sensor stopped or faulty). magic is written last, so a reader that sees it
+// sees the whole description. Timestamps are CLOCK_MONOTONIC (steady clock) ns, comparable between
+// the processes of one host.
+struct ShmRingHeader
+{
+    static constexpr std::uint32_t magic_value = 0x474E5253;   // "SRNG"
+    static constexpr std::uint32_t current_version = 1;
+
+    std::atomic<std::uint32_t> magic;           // magic_value once the region is initialized
+    std::uint32_t version;                      // Layout version
+    std::uint32_t header_size;                  // sizeof(ShmRingHeader)
+    std::uint32_t slot_size;                    // sizeof(ShmSlot)
+    std::uint64_t capacity;                     // Number of slots (power of two)
+    std::uint32_t writer_pid;                   // Process of the writer
+    std::uint32_t reserved;
+    double frequency;                           // Nominal sample rate in Hz
+    char kind[8];                               // Sensor type, e.g. "IMU" (NUL-terminated)
+    char sensor[32];                            // Sensor name (NUL-terminated)
+    alignas(64) std::atomic<std::uint64_t> head;    // Samples published (index of the next one)
+    std::atomic<std::uint64_t> floor;               // Samples below are withdrawn
+};
+
+// One sample slot of the ring
+struct alignas(64) ShmSlot
+{
+    std::atomic<std::uint64_t> sequence;    // 2 * index + 2 when stable, odd while written
+    std::int64_t timestamp_ns;              // Generation time (steady clock)
+    std::array<double, 3> values;           // Sample values
+};
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "The shared ring needs address-free 64-bit atomics");
+static_assert(sizeof(ShmRingHeader) == 192 && sizeof(ShmSlot) == 64, "Shared ring layout changed: bump the version");
+
+// Writer side: creates the named region (replacing a stale one of a previous run) and publishes
+// the samples of one sensor, wait-free. The region is unlinked when the writer is destroyed;
+// readers keep their mapping until they detach.
+class ShmRingWriter
+{
+    public:
+        // Constructor: create the region "/<name>" with at least capacity slots (check isOpen() for errors)
+        ShmRingWriter(const std::string& name, const std::string& sensor, const std::string& kind,
+                      std::size_t capacity, double frequency);
+
+        // Destructor: unmap and unlink the region
+        ~ShmRingWriter();
+
+        ShmRingWriter(const ShmRingWriter&) = delete;
+        ShmRingWriter& operator=(const ShmRingWriter&) = delete;
+
+        // Check if the region is mapped
+        bool isOpen() const { return header_ != nullptr; }
+
+        // Get the region name
+        const std::string& getName() const { return name_; }
+
+        // Publish one sample (writer thread only, wait-free)
+        void publish(std::int64_t timestamp_ns, const std::array<double, 3>& values)
+        {
+            const std::uint64_t index = header_->head.load(std::memory_order_relaxed);
+            ShmSlot& slot = slots_[index & mask_];
+            slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            slot.timestamp_ns = timestamp_ns;
+            slot.values = values;
+            slot.sequence.store(2 * index + 2, std::memory_order_release);
+            header_->head.store(index + 1, std::memory_order_release);
+        }
+
+        // Withdraw the published samples (sensor stopped or faulty)
+        void clear() { header_->floor.store(header_->head.load(std::memory_order_relaxed), std::memory_order_release); }
+
+    private:
+        std::string name_;                  // Region name
+        void* mapping_ = nullptr;           // Mapped region
+        std::size_t size_ = 0;              // Mapped size
+        ShmRingHeader* header_ = nullptr;   // Header of the region
+        ShmSlot* slots_ = nullptr;          // Slots of the region
+        std::uint64_t mask_ = 0;            // Capacity - 1
+};
+
+// Reader side: maps a region read-only. Nothing is copied out of the mapping except by read() and
+// latest(); a reader never writes to the region, so any number of processes can attach.
+class ShmRingReader
+{
+    public:
+        // Sample copied out of the ring
+        struct Sample
+        {
+            std::uint64_t index;                // Sample index
+            std::int64_t timestamp_ns;          // Generation time (steady clock)
+            std::array<double, 3> values;       // Sample values
+        };
+
+        // Constructor: map the region "/<name>" read-only (check isOpen() for errors: missing,
+        // not initialized yet, or another layout version)
+        explicit ShmRingReader(const std::string& name);
+
+        // Destructor: unmap the region
+        ~ShmRingReader();
+
+        ShmRingReader(const ShmRingReader&) = delete;
+        ShmRingReader& operator=(const ShmRingReader&) = delete;
+
+        // Check if the region is mapped
+        bool isOpen() const { return header_ != nullptr; }
+
+        // Description of the ring
+        const std::string& getName() const { return name_; }
+        std::string getSensor() const { return header_->sensor; }
+        std::string getKind() const { return header_->kind; }
+        double getFrequency() const { return header_->frequency; }
+        std::size_t capacity() const { return static_cast<std::size_t>(mask_ + 1); }
+
+        // Index range of the readable samples: [tail(), head())
+        std::uint64_t head() const { return header_->head.load(std::memory_order_acquire); }
+        std::uint64_t tail() const
+        {
+            const std::uint64_t head = this->head();
+            const std::uint64_t floor = header_->floor.load(std::memory_order_acquire);
+            const std::uint64_t oldest = head > capacity() ? head - capacity() : 0;
+            return floor > oldest ? floor : oldest;
+        }
+
+        // Copy out one sample; false if it is not readable (overwritten, withdrawn or not published)
+        bool read(std::uint64_t index, Sample& sample) const;
+
+        // Copy out the latest sample, if any
+        std::optional<Sample> latest() const;
+
+        // Visit (oldest to newest) the readable samples from an index: visitor(index, const Sample&).
+        // Each sample is copied out with read(), so a sample overwritten by the writer while being
+        // read is skipped, never seen torn. Returns the head at the start of the visit.
+        template <typename Visitor>
+        std::uint64_t forEachSince(std::uint64_t from, Visitor&& visitor) const
+        {
+            const std::uint64_t head = this->head();
+            Sample sample;
+            for (std::uint64_t index = from > tail() ? from : tail(); index < head; index++)
+            {
+                if (!read(index, sample))
+                    continue; // Overwritten or withdrawn by the writer meanwhile
+                visitor(index, sample);
+            }
+            return head;
+        }
+
+    private:
+        std::string name_;                          // Region name
+        const void* mapping_ = nullptr;             // Mapped region
+        std::size_t size_ = 0;                      // Mapped size
+        const ShmRingHeader* header_ = nullptr;     // Header of the region
+        const ShmSlot* slots_ = nullptr;            // Slots of the region
+        std::uint64_t mask_ = 0;                    // Capacity - 1
+};
@@ -4,63 +4,123 @@
 #include <vector>
 #include <string>
 #include <memory>
+#include <random>
 
 // Includes your project's headers
 #include "ImuSensor.hpp"
 #include "GnssSensor.hpp"
+#include "SensorSuite.hpp"
 #include "ProcessingUnit.hpp"
 #include "Fdir.hpp"
 #include "Simulator.hpp"
 #include "Logger.hpp"
+#include "Reactor.hpp"
+#include "Scenario.hpp"
 
-// IMU Configuration
-std::unordered_map<std::string, std::tuple<double, int, double>> imu_sensors_config = {
-    {"imu1", {100.0, 1000, 0.01}},
-    {"imu2", {100.0, 1000, 0.01}},
-    {"imu3", {100.0, 1000, 0.01}}
-};
+// Sensor suite file (see config/sensors.conf); the built-in suite below is used if it cannot be read
+const std::string sensor_config_file = "../config/sensors.conf";
 
-// GNSS Configuration
-std::unordered_map<std::string, std::tuple<double, int, double>> gnss_sensors_config = {
-    {"gnss1", {20.0, 1000, 0.01}},
-    {"gnss2", {20.0, 1000, 0.01}}
+// Built-in sensor suite: type, group name, count, frequency (Hz), noise (standard deviation)
+const std::vector<SensorGroup> default_sensor_groups = {
+    {SensorKind::Imu, "imu", 3, 100.0, 0.01},
+    {SensorKind::Gnss, "gnss", 2, 20.0, 0.01}
 };
 
-// FDIR and ProcessingUnit frequencies
+// Master seed of the sensor noise (0 = random; the seed in use is logged so a run can be replayed)
+const std::uint64_t master_seed = 0;
+
+// Replay of a recorded run instead of the simulated suite: data directory holding imu.csv/gnss.csv
+// (or imu.bin/gnss.bin), "" = simulate. The speed scales the recorded timing (0 = as fast as possible).
+const std::string replay_directory = "";
+const double replay_speed = 1.0;
+
+// ProcessingUnit frequency (FDIR runs at the lowest sensor frequency)
 const double processing_freq = 50.0; 
-const double fdir_freq = 20.0; // TODO: set the minimum sensor frequency dynamically
+
+// Data-driven fusion: fuse as soon as N IMUs have new samples (0 = poll at processing_freq)
+const std::size_t imu_quorum = 0;
+
+// Fusion engine: IMU mean and newest GNSS position (Average) or IMU/GNSS error-state Kalman filter (Kalman)
+const FusionEngine fusion_engine = FusionEngine::Average;
+
+// ProcessingUnit output format (Csv or Binary)
+const RecordingFormat recording_format = RecordingFormat::Csv;
+
+// CSV flush policy: every N rows (0 = off), every T ms, on crash signals
+const FlushPolicy flush_policy{0, std::chrono::milliseconds(500), true};
+
+// Execution mode: one thread per component, a single reactor thread driving all of them,
+// or a reactor dispatching the ticks to a work-stealing pool with one worker per core
+const ExecutionMode execution_mode = ExecutionMode::ThreadPerComponent;
+
+// Runtime metrics snapshot (Prometheus text format) rewritten every interval while running ("" = off)
+const std::string metrics_file = "../metrics/metrics.prom";
+const std::chrono::milliseconds metrics_interval{1000};
+
+// Shared memory rings: every sensor also publishes into "/<prefix><sensor name>", readable by other
+// processes (see sensors-shm-monitor); "" = off
+const std::string shared_memory_prefix = "";
 
 // Fault injection configuration
 const int injection_duration = 5; // Duration of fault injection in seconds
 
-// Instantiate IMU sensors
-void instantiateImuSensors(
-    std::vector<std::shared_ptr<ImuSensor>>& imu_sensors, 
-    const std::unordered_map<std::string, std::tuple<double, int, double>>& imu_sensors_config) 
+// Open a recorded stream of the replay directory (nullptr if there is none)
+std::shared_ptr<ReplaySource> openReplay(const std::string& stream)
 {
-    for (const auto& [name, params] : imu_sensors_config) {
-        imu_sensors.push_back(std::make_shared<ImuSensor>(
-            name, 
-            std::get<0>(params), 
-            std::get<1>(params), 
-            std::get<2>(params))
-        );
+    for (const char* extension : {".csv", ".bin"})
+    {
+        auto source = std::make_shared<ReplaySource>(replay_directory + "/" + stream + extension);
+        if (source->isOpen())
+            return source;
     }
+    Logger::log(Logger::Level::Error, "[Interface] No recorded " + stream + " stream in " + replay_directory);
+    return nullptr;
 }
 
-// Instantiate GNSS sensors
-void instantiateGnssSensors(
-    std::vector<std::shared_ptr<GnssSensor>>& gnss_sensors, 
-    const std::unordered_map<std::string, std::tuple<double, int, double>>& gnss_sensors_config) 
+// Settings of the interactive mode, and defaults of a headless run
+Scenario defaultScenario()
 {
-    for (const auto& [name, params] : gnss_sensors_config) {
-        gnss_sensors.push_back(std::make_shared<GnssSensor>(
-            name, 
-            std::get<0>(params), 
-            std::get<1>(params), 
-            std::get<2>(params))
-        );
+    Scenario scenario;
+    scenario.seed = master_seed;
+    scenario.sensor_config = sensor_config_file;
+    scenario.execution_mode = execution_mode;
+    scenario.fusion_engine = fusion_engine;
+    scenario.recording_format = recording_format;
+    scenario.metrics_file = metrics_file;
+    scenario.shared_memory = shared_memory_prefix;
+    return scenario;
+}
+
+// Read the sensor suite file, or fall back to the built-in suite
+std::vector<SensorGroup> loadSensorSuite(const std::string& path)
+{
+    std::vector<SensorGroup> groups;
+    std::string error;
+    if (loadSensorGroups(path, groups, error))
+    {
+        Logger::log(Logger::Level::Info, "[Interface] Sensor suite: " + path + " (" + std::to_string(groups.size()) + " groups)");
+        return groups;
     }
+    Logger::log(Logger::Level::Warning, "[Interface] Using the built-in sensor suite: " + error);
+    return default_sensor_groups;
+}
+
+// Instanciate a sensor replaying a recorded stream (none if the stream is missing)
+template <typename SensorT>
+void addReplaySensor(std::vector<std::shared_ptr<SensorT>>& sensors, const std::string& stream)
+{
+    auto source = openReplay(stream);
+    if (!source)
+        return;
+
+    // The nominal rate drives the FDIR deadlines and the timing report
+    double frequency = source->estimateFrequency() * (replay_speed > 0.0 ? replay_speed : 1.0);
+    if (frequency <= 0.0)
+        frequency = processing_freq;
+    auto sensor = std::make_shared<SensorT>(stream + "_replay", frequency, 0.0);
+    sensor->setReplay(source, replay_speed);
+    sensors.push_back(sensor);
+    Logger::log(Logger::Level::Info, "[Interface] Replaying " + source->getPath() + " at " + std::to_string(frequency) + " Hz");
 }
 
 void instantiateSimulation(
@@ -68,43 +128,134 @@ void instantiateSimulation(
     std::vector<std::shared_ptr<GnssSensor>>& gnss_sensors,
     std::shared_ptr<ProcessingUnit>& processing_unit,
     std::shared_ptr<Fdir>& fdir,
-    std::unique_ptr<Simulator>& simulator
+    std::unique_ptr<Simulator>& simulator,
+    std::shared_ptr<Executor> executor,
+    const Scenario& scenario
     )
 {
-    // Instanciate IMU sensors
-    instantiateImuSensors(imu_sensors, imu_sensors_config);
+    // Instanciate the sensors of the suite (in bulk, one block per group), or the replays of a recorded run
+    std::vector<SensorGroup> groups;
+    if (replay_directory.empty())
+    {
+        groups = loadSensorSuite(scenario.sensor_config);
+        const auto start = std::chrono::steady_clock::now();
+        imu_sensors = makeSensors<ImuSensor>(groups, SensorKind::Imu);
+        gnss_sensors = makeSensors<GnssSensor>(groups, SensorKind::Gnss);
+        Logger::log(Logger::Level::Info, "[Interface] Instantiated " + std::to_string(imu_sensors.size() + gnss_sensors.size()) + " sensors in " +
+            std::to_string(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count()) + " us");
+    }
+    else
+    {
+        addReplaySensor(imu_sensors, "imu");
+        addReplaySensor(gnss_sensors, "gnss");
+        groups = {{SensorKind::Imu, "imu", imu_sensors.size(), 1.0, 0.0}, {SensorKind::Gnss, "gnss", gnss_sensors.size(), 1.0, 0.0}};
+    }
 
-    // Instanciate GNSS sensors
-    instantiateGnssSensors(gnss_sensors, gnss_sensors_config);
+    // Seed every noise stream from the master seed
+    std::uint64_t seed = scenario.seed;
+    if (seed == 0)
+        seed = (static_cast<std::uint64_t>(std::random_device{}()) << 32) | std::random_device{}();
+    Logger::log(Logger::Level::Info, "[Interface] Sensor noise master seed: " + std::to_string(seed));
+    for (auto& imu_sensor : imu_sensors)
+        imu_sensor->setSeed(seed);
+    for (auto& gnss_sensor : gnss_sensors)
+        gnss_sensor->setSeed(seed);
+
+    // Mirror the samples into shared memory for the consumers of other processes
+    if (!scenario.shared_memory.empty())
+    {
+        for (auto& imu_sensor : imu_sensors)
+            imu_sensor->shareSamples(scenario.shared_memory + imu_sensor->getName());
+        for (auto& gnss_sensor : gnss_sensors)
+            gnss_sensor->shareSamples(scenario.shared_memory + gnss_sensor->getName());
+        Logger::log(Logger::Level::Info, "[Interface] Sensor samples shared in /dev/shm/" + scenario.shared_memory + "*");
+    }
 
     // Instanciate ProcessingUnit
     processing_unit = std::make_shared<ProcessingUnit>(
         imu_sensors, 
         gnss_sensors, 
-        processing_freq
+        processing_freq,
+        scenario.recording_format,
+        flush_policy,
+        scenario.data_directory
     );
+    processing_unit->setDataDriven(imu_quorum);
+    processing_unit->setFusionEngine(scenario.fusion_engine);
 
     // Instanciate FDIR
-    fdir = std::make_shared<Fdir>(processing_unit, fdir_freq);
+    fdir = std::make_shared<Fdir>(processing_unit);
     
-    // Add IMU sensors to FDIR
-    for (auto& imu_sensor : imu_sensors) {
-        fdir->addSensor(imu_sensor); 
+    // Add the sensors to FDIR, one redundancy group per sensor group
+    std::size_t imu_index = 0;
+    std::size_t gnss_index = 0;
+    for (const SensorGroup& group : groups)
+    {
+        for (std::size_t i = 0; i < group.count; i++)
+        {
+            if (group.kind == SensorKind::Imu && imu_index < imu_sensors.size())
+                fdir->addSensor(imu_sensors[imu_index++], group.name);
+            else if (group.kind == SensorKind::Gnss && gnss_index < gnss_sensors.size())
+                fdir->addSensor(gnss_sensors[gnss_index++], group.name);
+        }
     }
 
-    // Add GNSS sensors to FDIR
-    for (auto& gnss_sensor : gnss_sensors) {
-        fdir->addSensor(gnss_sensor); 
+    // Run every component on the executor, if any
+    if (executor)
+    {
+        for (auto& imu_sensor : imu_sensors)
+            imu_sensor->setExecutor(executor);
+        for (auto& gnss_sensor : gnss_sensors)
+            gnss_sensor->setExecutor(executor);
+        processing_unit->setExecutor(executor);
+        fdir->setExecutor(executor);
     }
 
     // Instantiate the simulator
     simulator = std::make_unique<Simulator>(imu_sensors, gnss_sensors, processing_unit, fdir);
+    simulator->setMetricsExport(scenario.metrics_file, metrics_interval);
 }
 
+// Command line of a headless run
+const char* usage = R"(Usage: multi-threaded-sensors-simulation                 interactive mode
+       multi-threaded-sensors-simulation --<setting> <value>... headless run
+Settings (a scenario file holds the same keys, one "<key> <value...>" per line):
+  --scenario <file>             load a scenario file (later arguments override it)
+  --duration <s>                run duration (default 10)
+  --seed <n>                    master noise seed (0 = random)
+  --config <file>               sensor suite file
+  --mode thread|reactor|pool    execution mode
+  --fusion average|kalman       fusion engine
+  --format csv|binary           recording format
+  --data <dir>                  recording directory
+  --log <dir>                   log directory
+  --console on|off              echo the log to the console
+  --metrics <file>|off          metrics snapshot file
+  --shm <prefix>|off            also publish every sensor into the shared memory ring /<prefix><name>
+  --fault <start>:<end>:<target>  inject a fault from start to end s (end = "end" for the whole run)
+                                on "imu", "gnss" or a sensor name (repeatable)
+)";
+
 // Main function
-int main() {
+int main(int argc, char** argv) {
+    // Settings: the defaults above, or the command line of a headless run
+    Scenario scenario = defaultScenario();
+    const bool headless = argc > 1;
+    std::string error;
+    if (headless && !parseScenarioArguments(argc, argv, scenario, error))
+    {
+        std::cerr << "[Interface] " << error << "\n" << usage;
+        return 2;
+    }
+
     // Initialize the logger
-    Logger::init();
+    Logger::Config log_config;
+    log_config.console = scenario.console;
+    log_config.directory = scenario.log_directory;
+    Logger::init(log_config);
+
+    // Write out the pending CSV rows if the process is interrupted or crashes
+    CsvWriter::installSignalHandlers();
 
     // Instantiate the simulation components
     std::vector<std::shared_ptr<ImuSensor>> imu_sensors;
@@ -112,7 +263,34 @@ int main() {
     std::shared_ptr<ProcessingUnit> processing_unit;
     std::shared_ptr<Fdir> fdir;
     std::unique_ptr<Simulator> simulator;
-    instantiateSimulation(imu_sensors, gnss_sensors, processing_unit, fdir, simulator);
+    std::shared_ptr<Reactor> reactor;
+    if (scenario.execution_mode == ExecutionMode::Reactor)
+    {
+        reactor = std::make_shared<Reactor>();
+        reactor->start();
+    }
+    else if (scenario.execution_mode == ExecutionMode::WorkerPool)
+    {
+        reactor = std::make_shared<Reactor>(std::make_shared<WorkerPool>());
+        reactor->start();
+    }
+    instantiateSimulation(imu_sensors, gnss_sensors, processing_unit, fdir, simulator, reactor, scenario);
+
+    // Headless run: play the scenario, print the summary and exit
+    if (headless)
+    {
+        runScenario(*simulator, scenario);
+        // Logged (and echoed on the console, if on) or else printed, so that stdout holds it once
+        std::istringstream summary(simulator->summary());
+        for (std::string line; std::getline(summary, line);)
+        {
+            Logger::log(Logger::Level::Info, "[Summary] " + line);
+            if (!scenario.console)
+                std::cout << "[Summary] " << line << "\n";
+        }
+        Logger::shutdown();
+        return 0;
+    }
 
     // Start the interactive command loop
     std::string command;
@@ -126,6 +304,8 @@ int main() {
         4 - Use Case 2 (inject IMU faults for 5 seconds)
         5 - Use Case 3 (inject GNSS faults for 5 seconds)
         6 - Exit
+        7 - Show the latency percentiles (also while running)
+        8 - Show the runtime metrics (also while running)
         )";
     std::cout << interface << std::endl;
 
@@ -137,7 +317,7 @@ int main() {
         std::cout << "[Interface] Digit the number (e.g. for 'Start' digit '1') >> ";
         std::cin >> command;
         
-        if (start == true && command != "2" && command != "6") 
+        if (start == true && command != "2" && command != "6" && command != "7" && command != "8") 
         {
             Logger::log(Logger::Level::Warning, "[Interface] You must stop the simulation before executing other commands.");
             continue;
@@ -160,20 +340,17 @@ int main() {
         {
             simulator->start();
             start = true;
-            std::this_thread::sleep_for(std::chrono::seconds(1));
             Logger::log(Logger::Level::Info, "[Interface] Simulation running... Check CSV files to see the data");
         } 
         else if (command == "2") 
         {
             simulator->stop();
             start = false;
-            std::this_thread::sleep_for(std::chrono::seconds(1));
             Logger::log(Logger::Level::Info, "[Interface] Simulation stopped.");
         } 
         else if (command == "3") 
         {
             simulator->start(); // Start the simulator
-            std::this_thread::sleep_for(std::chrono::seconds(1)); 
             Logger::log(Logger::Level::Info, "[Interface] Simulating for 10 seconds... Check CSV files to see the data");
             std::this_thread::sleep_for(std::chrono::seconds(10));
             simulator->stop(); // Stop the simulator 
@@ -205,14 +382,24 @@ int main() {
             Logger::log(Logger::Level::Info, "[Interface] Exiting the simulator. Check the log file for details.");
             break;
         } 
+        else if (command == "7") 
+        {
+            simulator->logLatencies();
+        } 
+        else if (command == "8") 
+        {
+            std::cout << simulator->metricsSnapshot() << std::flush;
+        } 
         else 
         {
             Logger::log(Logger::Level::Warning, "[Interface] Command not valid: " + command);
         }
     }
 
-    std::this_thread::sleep_for(std::chrono::seconds(1));
     Logger::log(Logger::Level::Info, "[Interface] Bye!");
 
+    // Write out the queued log messages
+    Logger::shutdown();
+
     return 0;
 }
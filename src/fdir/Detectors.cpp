@@ -0,0 +1,108 @@
+#include "Detectors.hpp"
+#include <cmath>
+
+namespace
+{
+    // Noise used for normalisation (noiseless sensors get a tiny floor to avoid dividing by zero)
+    double noiseScale(double noise) { return noise > 1e-12 ? noise : 1e-12; }
+}
+
+// Feed a sample; returns true while the sensor is stuck
+bool StuckDetector::update(const std::array<double, 3>& values, std::size_t limit)
+{
+    repeats_ = has_last_ && values == last_ ? repeats_ + 1 : 0;
+    last_ = values;
+    has_last_ = true;
+    return repeats_ + 1 >= limit;
+}
+
+// Feed a sample; returns true while the last complete block was out of range
+bool NoiseDetector::update(const std::array<double, 3>& values, double noise, const DetectorConfig& config)
+{
+    if (has_last_)
+    {
+        for (std::size_t axis = 0; axis < 3; axis++)
+            differences_[axis].add(values[axis] - last_[axis]);
+    }
+    last_ = values;
+    has_last_ = true;
+
+    // Block complete: compare the measured noise with the nominal one on every axis
+    if (differences_[0].count() >= config.noise_block)
+    {
+        drift_ = false;
+        for (RunningStats& difference : differences_)
+        {
+            const double measured = std::sqrt(difference.variance() / 2.0);
+            const double ratio = measured / noiseScale(noise);
+            drift_ = drift_ || ratio > config.noise_ratio || ratio < 1.0 / config.noise_ratio;
+            difference.reset();
+        }
+    }
+    return drift_;
+}
+
+// Clear the detector state
+void NoiseDetector::reset()
+{
+    for (RunningStats& difference : differences_)
+        difference.reset();
+    has_last_ = false;
+    drift_ = false;
+}
+
+// Feed a residual (in noise units); returns true while a step is detected
+bool CusumDetector::update(const std::array<double, 3>& residual, const DetectorConfig& config)
+{
+    bool step = false;
+    for (std::size_t axis = 0; axis < 3; axis++)
+    {
+        high_[axis] = std::fmax(0.0, high_[axis] + residual[axis] - config.cusum_drift);
+        low_[axis] = std::fmax(0.0, low_[axis] - residual[axis] - config.cusum_drift);
+        step = step || high_[axis] > config.cusum_threshold || low_[axis] > config.cusum_threshold;
+    }
+    return step;
+}
+
+// Feed the distance from the group median (in noise units); returns true while isolated
+bool VoteDetector::update(const std::array<double, 3>& residual, const DetectorConfig& config)
+{
+    const bool disagree = std::fabs(residual[0]) > config.vote_threshold
+        || std::fabs(residual[1]) > config.vote_threshold
+        || std::fabs(residual[2]) > config.vote_threshold;
+    disagreements_ = disagree ? disagreements_ + 1 : 0;
+    return disagreements_ >= config.vote_samples;
+}
+
+// Feed a sample
+void SensorDetectors::update(const std::array<double, 3>& values, const std::optional<std::array<double, 3>>& median,
+                             bool voting, double noise, const DetectorConfig& config)
+{
+    // Value and noise checks only make sense on a noisy sensor (a noiseless one always repeats)
+    if (noise > 0.0)
+    {
+        faults_.stuck = stuck_.update(values, config.stuck_samples);
+        faults_.noise = noise_.update(values, noise, config);
+    }
+    if (!median)
+        return;
+
+    // Residual against the redundant units (the difference of two noisy units has sqrt(2) times the noise)
+    std::array<double, 3> residual{};
+    const double scale = noiseScale(noise) * std::sqrt(2.0);
+    for (std::size_t axis = 0; axis < 3; axis++)
+        residual[axis] = (values[axis] - (*median)[axis]) / scale;
+    faults_.bias = cusum_.update(residual, config);
+    if (voting)
+        faults_.outvoted = vote_.update(residual, config);
+}
+
+// Clear the detector state (sensor restarted)
+void SensorDetectors::reset()
+{
+    stuck_.reset();
+    noise_.reset();
+    cusum_.reset();
+    vote_.reset();
+    faults_ = SampleFaults();
+}
@@ -1,19 +1,90 @@
 #include "Fdir.hpp"
 #include <iostream>
+#include <algorithm>
 
-// Constructor
+namespace
+{
+    // Current steady clock time in ns (same timeline as the sensor heartbeats)
+    std::int64_t nowNs()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // Number of missing nominal intervals after which a sensor has failed
+    constexpr std::int64_t missed_intervals = 3;
+
+    // Alarms kept on the fdir/alarms topic for the subscribers
+    constexpr std::size_t alarm_topic_capacity = 256;
+
+    // Sensors queued with new samples (a sensor is queued at most once per pass; beyond the
+    // capacity, a sensor retries on its next sample)
+    constexpr std::size_t sample_queue_capacity = 4096;
+
+    // Token of a slot on the sample queue (the generation discards the tokens of removed sensors)
+    std::uint64_t sampleToken(std::size_t slot, std::uint32_t generation)
+    {
+        return static_cast<std::uint64_t>(generation) << 32 | static_cast<std::uint32_t>(slot);
+    }
+
+    // Sample time in ns
+    std::int64_t sampleNs(const Sensor::Sample& sample)
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(sample.timestamp.time_since_epoch()).count();
+    }
+}
+
+// Constructor (frequency 0 = run at the lowest registered sensor frequency)
 Fdir::Fdir(std::shared_ptr<ProcessingUnit> processing_unit, double frequency) : 
-    processing_unit_(processing_unit), frequency_(frequency) 
+    frequency_(frequency > 0.0 ? frequency : 1.0), derived_frequency_(frequency <= 0.0), processing_unit_(processing_unit),
+    sample_queue_(std::make_shared<MpscQueue<std::uint64_t>>(sample_queue_capacity)),
+    output_subscription_(processing_unit->getOutputTopic()->subscribe("fdir")),
+    alarm_topic_(std::make_shared<Topic<FdirAlarm>>("fdir/alarms", alarm_topic_capacity))
 {
+    ready_tokens_.reserve(sample_queue_capacity);
 }
 
 // Start the FDIR thread
 void Fdir::start() 
 {
     //std::cout << "[Fdir] Start" << std::endl;
-    Logger::log(Logger::Level::Info, "[Fdir] Start");
+    Logger::log(Logger::Level::Info, "[Fdir] Start at " + std::to_string(frequency_.load()) + " Hz");
     running_ = true;
-    thread_ = std::thread(&Fdir::run, this);
+    timing_.reset();
+    sample_latency_.reset();
+    silence_latency_.reset();
+    metrics_.reset();
+    output_subscription_->skip();
+
+    // Monitor every sensor from now on
+    {
+        std::lock_guard<std::mutex> lock(fdir_mutex_);
+        deadlines_ = {};
+        detections_ = FdirDetections();
+        const std::int64_t now = nowNs();
+        for (std::size_t slot = 0; slot < sensors_.size(); slot++)
+        {
+            MonitoredSensor& monitored = sensors_[slot];
+            if (!monitored.sensor)
+                continue;
+            monitored.since_ns = now;
+            monitored.failed = false;
+            schedule(slot, now + missed_intervals * monitored.period_ns);
+
+            // Detectors restart from the next sample
+            monitored.cursor = monitored.sensor->getSampleHead();
+            monitored.has_next = false;
+            monitored.last_ns = 0;
+            monitored.detectors.reset();
+            monitored.reported = SampleFaults();
+        }
+    }
+
+    // Run on the executor if one is set, otherwise on a dedicated thread
+    if (executor_)
+        task_id_ = executor_->add({"Fdir", [this] { return frequency_.load(); }, [this] { timing_.record(frequency_); tick(); }});
+    else
+        thread_ = std::thread(&Fdir::run, this);
 }
 
 // Stop the FDIR thread
@@ -21,18 +92,71 @@ void Fdir::stop()
 {
     Logger::log(Logger::Level::Info, "[Fdir] Stop");
     running_ = false;
+
+    // Unschedule from the executor
+    if (executor_ && task_id_ != 0)
+    {
+        executor_->remove(task_id_);
+        task_id_ = 0;
+    }
     
     // Wait for thread to finish
     if (thread_.joinable())
         thread_.join();
+
+    // Report the measured rate and jitter
+    Logger::log(Logger::Level::Info, "[Fdir] Timing: " + timing_.summary());
 }
 
-// Add a sensor
-void Fdir::addSensor(std::shared_ptr<Sensor> sensor) 
+// Add a sensor, optionally to a group of redundant units voting against each other
+void Fdir::addSensor(std::shared_ptr<Sensor> sensor, const std::string& group) 
 {
     Logger::log(Logger::Level::Info, "[Fdir] Adding sensor: " + sensor->getName());
     std::lock_guard<std::mutex> lock(fdir_mutex_);
-    sensors_[sensor->getName()] = {sensor, 0, sensor->getFrequency()}; // Add the sensor to the map
+    if (slot_by_name_.count(sensor->getName()) > 0)
+        return; // Already monitored
+
+    // Reuse a free slot to keep the array dense
+    std::size_t slot = sensors_.size();
+    if (!free_slots_.empty())
+    {
+        slot = free_slots_.back();
+        free_slots_.pop_back();
+    }
+    else
+        sensors_.push_back({});
+
+    // Nominal measurement interval from the registration frequency
+    const double frequency = sensor->getFrequency() > 0.0 ? sensor->getFrequency() : 1.0;
+    MonitoredSensor& monitored = sensors_[slot];
+    monitored.sensor = sensor;
+    monitored.name = sensor->getName();
+    monitored.period_ns = static_cast<std::int64_t>(1e9 / frequency);
+    monitored.since_ns = nowNs();
+    monitored.failed = false;
+    monitored.cursor = sensor->getSampleHead();
+    monitored.has_next = false;
+    monitored.last_ns = 0;
+    monitored.detectors.reset();
+    monitored.reported = SampleFaults();
+    slot_by_name_[monitored.name] = slot;
+    sensor->setSampleQueue(sample_queue_, sampleToken(slot, monitored.generation));
+
+    // Join the redundancy group (created on first use)
+    monitored.group = no_group;
+    if (!group.empty())
+    {
+        auto it = std::find_if(groups_.begin(), groups_.end(), [&](const Group& existing) { return existing.name == group; });
+        if (it == groups_.end())
+            it = groups_.insert(groups_.end(), Group{group, {}});
+        it->slots.push_back(slot);
+        it->ready.reserve(it->slots.size());
+        monitored.group = static_cast<std::size_t>(it - groups_.begin());
+        ready_groups_.reserve(groups_.size());
+    }
+
+    schedule(slot, monitored.since_ns + missed_intervals * monitored.period_ns);
+    updateFrequency();
 }
 
 // Remove a sensor
@@ -40,70 +164,350 @@ void Fdir::removeSensor(const std::string& name)
 {
     Logger::log(Logger::Level::Info, "[Fdir] Removing sensor: " + name);
     std::lock_guard<std::mutex> lock(fdir_mutex_);
-    sensors_.erase(name); // Remove the sensor from the map
+    auto it = slot_by_name_.find(name);
+    if (it == slot_by_name_.end())
+        return;
+
+    // Free the slot; its pending deadline is skipped thanks to the generation
+    MonitoredSensor& monitored = sensors_[it->second];
+    if (monitored.group != no_group)
+    {
+        std::vector<std::size_t>& slots = groups_[monitored.group].slots;
+        slots.erase(std::remove(slots.begin(), slots.end(), it->second), slots.end());
+    }
+    monitored.sensor.reset();
+    monitored.generation++;
+    free_slots_.push_back(it->second);
+    slot_by_name_.erase(it);
+    updateFrequency();
+}
+
+// Get the faults reported since the last start
+FdirDetections Fdir::getDetections() const
+{
+    std::lock_guard<std::mutex> lock(fdir_mutex_);
+    return detections_;
 }
 
 // Processing unit loop
 void Fdir::run() 
 {
+    // Absolute deadlines: the work time does not shift the next period
+    PeriodicTimer timer(&timing_);
+    timer.start(frequency_);
     while (running_) 
     {
+        tick();
+        timer.wait(frequency_);
+    }
+}
+
+// One iteration of the FDIR loop
+void Fdir::tick() 
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    // Check the sensors status
+    checkSensors();
+
+    // Run the detectors on the new samples
+    checkSamples();
+
+    // Check the processing unit status
+    checkProcessingUnit();
+
+    metrics_.recordTick(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+}
+
+// Check the sensors whose failure deadline has passed
+void Fdir::checkSensors() 
+{
+    std::vector<std::string> failed;
+    std::vector<std::string> recovered;
+    {
+        MeteredLock lock(fdir_mutex_, metrics_);
+        const std::int64_t now = nowNs();
+        while (!deadlines_.empty() && deadlines_.top().deadline_ns <= now)
         {
-            std::lock_guard<std::mutex> lock(fdir_mutex_);
+            const Deadline due = deadlines_.top();
+            deadlines_.pop();
+
+            MonitoredSensor& monitored = sensors_[due.slot];
+            if (!monitored.sensor || monitored.generation != due.generation)
+                continue; // Removed meanwhile
 
-            // Check the sensors status
-            checkSensors();
+            // Stopped sensor: no output expected, watch it again from now; its detectors start over
+            if (!monitored.sensor->isRunning()) 
+            {
+                monitored.since_ns = now;
+                monitored.cursor = monitored.sensor->getSampleHead();
+                monitored.has_next = false;
+                monitored.last_ns = 0;
+                monitored.detectors.reset();
+                monitored.reported = SampleFaults();
+                schedule(due.slot, now + missed_intervals * monitored.period_ns);
+                continue;
+            }
 
-            // Check the processing unit status
-            checkProcessingUnit();
+            // Last output (or start of monitoring, whichever is later)
+            const std::int64_t last = std::max(monitored.sensor->getHeartbeat(), monitored.since_ns);
+            if (now - last >= missed_intervals * monitored.period_ns)
+            {
+                // Check again after one nominal interval to see it recover
+                if (!monitored.failed)
+                {
+                    monitored.failed = true;
+                    failed.push_back(monitored.name);
+                    detections_.silent++;
+                    publishAlarm(FdirAlarmKind::Silent, true, monitored.name, now);
+                    silence_latency_.record(now - last);
+                }
+                schedule(due.slot, now + monitored.period_ns);
+            }
+            else
+            {
+                // Output received: next failure deadline from the last output
+                if (monitored.failed)
+                {
+                    monitored.failed = false;
+                    recovered.push_back(monitored.name);
+                    detections_.recovered++;
+                    publishAlarm(FdirAlarmKind::Silent, false, monitored.name, now);
+                }
+                schedule(due.slot, last + missed_intervals * monitored.period_ns);
+            }
         }
-        
-        int sleep_time_ms = static_cast<int>(1000 / frequency_);
-        std::this_thread::sleep_for(std::chrono::milliseconds(sleep_time_ms));
     }
+
+    // Report outside the lock
+    for (const std::string& name : failed)
+        Logger::log(Logger::Level::Error, "[Fdir] Sensor " + name + " did not provide any output for three consecutive nominal measurement intervals");
+    for (const std::string& name : recovered)
+        Logger::log(Logger::Level::Info, "[Fdir] Sensor " + name + " is providing output again");
 }
 
-// Check the sensors status
-void Fdir::checkSensors() 
+// Feed the new samples of the sensors queued since the last pass to their detectors and report the changes
+void Fdir::checkSamples()
 {
-    for (auto& [name, sensor_info] : sensors_) 
+    // Sensors with new samples (lock-free): nothing to do, nothing locked on a quiet cycle
+    ready_tokens_.clear();
+    std::uint64_t token = 0;
+    while (sample_queue_->tryPop(token))
+        ready_tokens_.push_back(token);
+    if (ready_tokens_.empty())
+        return;
+
+    std::vector<std::pair<Logger::Level, std::string>> reports;
     {
-        auto& [sensor, counter, measurement_frequency] = sensor_info;
-        
-        // Check if the sensor is running
-        if (!sensor->isRunning()) 
-        {
-            //std::cerr << "[Fdir] Sensor " << name << " is not running." << std::endl;
-            continue; // Skip to the next sensor
-        } 
+        MeteredLock lock(fdir_mutex_, metrics_);
+        const std::int64_t now = nowNs();
 
-        auto time_step = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - sensor->getLastUpdate()).count();
-        if (time_step > 1000 / measurement_frequency) 
+        // Rearm each sensor before reading its samples; the units of a group are merged together
+        ready_groups_.clear();
+        for (const std::uint64_t ready : ready_tokens_)
         {
-            counter++;
+            std::size_t slot = static_cast<std::uint32_t>(ready);
+            if (slot >= sensors_.size() || !sensors_[slot].sensor || sampleToken(slot, sensors_[slot].generation) != ready)
+                continue; // Removed meanwhile
+            MonitoredSensor& monitored = sensors_[slot];
+            monitored.sensor->rearmSampleQueue();
+            if (monitored.group == no_group)
+            {
+                feedDetectors(&slot, 1, no_group, now, reports);
+                continue;
+            }
+            Group& group = groups_[monitored.group];
+            if (group.ready.empty())
+                ready_groups_.push_back(monitored.group);
+            group.ready.push_back(slot);
         }
-        else 
+        for (const std::size_t index : ready_groups_)
         {
-            counter = 0; // Reset the counter if the sensor is working properly
+            Group& group = groups_[index];
+            feedDetectors(group.ready.data(), group.ready.size(), index, now, reports);
+            group.ready.clear();
         }
+    }
+
+    // Report outside the lock
+    for (const auto& [level, message] : reports)
+        Logger::log(level, message);
+}
+
+// Feed the new samples of a set of sensors of one group (or no_group), merged in time order (lock held)
+void Fdir::feedDetectors(const std::size_t* slots, std::size_t count, std::size_t group, std::int64_t now,
+                         std::vector<std::pair<Logger::Level, std::string>>& reports)
+{
+    // Next sample of each sensor
+    for (std::size_t i = 0; i < count; i++)
+    {
+        MonitoredSensor& monitored = sensors_[slots[i]];
+        if (!monitored.has_next)
+            readAhead(monitored);
+    }
+
+    // Group median once per cycle, from the values of all its units at the start of the cycle
+    std::size_t units = 0;
+    std::optional<std::array<double, 3>> median;
+    if (group != no_group)
+        median = groupMedian(groups_[group], units);
+
+    // Oldest pending sample first (min-heap on the sample time, one entry per unit with a pending sample)
+    auto later = [](const PendingSample& a, const PendingSample& b) { return a.time_ns > b.time_ns; };
+    merge_heap_.clear();
+    for (std::size_t i = 0; i < count; i++)
+    {
+        const MonitoredSensor& monitored = sensors_[slots[i]];
+        if (monitored.has_next)
+            merge_heap_.push_back({sampleNs(monitored.next), slots[i]});
+    }
+    std::make_heap(merge_heap_.begin(), merge_heap_.end(), later);
+    while (!merge_heap_.empty())
+    {
+        std::pop_heap(merge_heap_.begin(), merge_heap_.end(), later);
+        const PendingSample oldest = merge_heap_.back();
+        merge_heap_.pop_back();
+
+        MonitoredSensor& monitored = sensors_[oldest.slot];
+        monitored.last_values = monitored.next.values;
+        monitored.last_ns = oldest.time_ns;
+        monitored.detectors.update(monitored.last_values, median, units >= 3, monitored.sensor->getNoise(), detector_config_);
+        sample_latency_.record(now - monitored.last_ns);
+        metrics_.addProduced();
+
+        monitored.cursor++;
+        monitored.has_next = false;
+        if (readAhead(monitored))
+        {
+            merge_heap_.push_back({sampleNs(monitored.next), oldest.slot});
+            std::push_heap(merge_heap_.begin(), merge_heap_.end(), later);
+        }
+    }
+
+    // Report the faults that appeared or cleared
+    for (std::size_t i = 0; i < count; i++)
+    {
+        MonitoredSensor& monitored = sensors_[slots[i]];
+        const SampleFaults& faults = monitored.detectors.faults();
+        if (faults == monitored.reported)
+            continue;
+
+        detections_.stuck += faults.stuck && !monitored.reported.stuck ? 1 : 0;
+        detections_.noise += faults.noise && !monitored.reported.noise ? 1 : 0;
+        detections_.bias += faults.bias && !monitored.reported.bias ? 1 : 0;
+        detections_.outvoted += faults.outvoted && !monitored.reported.outvoted ? 1 : 0;
+
+        if (faults.stuck != monitored.reported.stuck)
+            publishAlarm(FdirAlarmKind::Stuck, faults.stuck, monitored.name, now);
+        if (faults.noise != monitored.reported.noise)
+            publishAlarm(FdirAlarmKind::Noise, faults.noise, monitored.name, now);
+        if (faults.bias != monitored.reported.bias)
+            publishAlarm(FdirAlarmKind::Bias, faults.bias, monitored.name, now);
+        if (faults.outvoted != monitored.reported.outvoted)
+            publishAlarm(FdirAlarmKind::Outvoted, faults.outvoted, monitored.name, now);
+
+        const std::string sensor = "[Fdir] Sensor " + monitored.name;
+        const std::string group = monitored.group != no_group ? groups_[monitored.group].name : "";
+        if (faults.stuck != monitored.reported.stuck)
+            reports.push_back(faults.stuck
+                ? std::make_pair(Logger::Level::Error, sensor + " is stuck: identical samples repeated")
+                : std::make_pair(Logger::Level::Info, sensor + " is no longer stuck"));
+        if (faults.noise != monitored.reported.noise)
+            reports.push_back(faults.noise
+                ? std::make_pair(Logger::Level::Error, sensor + " noise level drifted from the nominal value")
+                : std::make_pair(Logger::Level::Info, sensor + " noise level is nominal again"));
+        if (faults.bias != monitored.reported.bias)
+            reports.push_back(faults.bias
+                ? std::make_pair(Logger::Level::Error, sensor + " bias step change detected against group " + group)
+                : std::make_pair(Logger::Level::Info, sensor + " bias is consistent with group " + group + " again"));
+        if (faults.outvoted != monitored.reported.outvoted)
+            reports.push_back(faults.outvoted
+                ? std::make_pair(Logger::Level::Error, sensor + " isolated: it disagrees with the median of group " + group)
+                : std::make_pair(Logger::Level::Info, sensor + " agrees with group " + group + " again"));
+        monitored.reported = faults;
+    }
+}
 
-        // Check if the sensor has failed
-        if (counter >= 3) 
+// Read the sample at the cursor of a slot, if any (lock held)
+bool Fdir::readAhead(MonitoredSensor& monitored)
+{
+    // Samples overwritten or cleared before being read are skipped (and counted as dropped)
+    auto skip = [&](std::uint64_t cursor) {
+        const std::uint64_t tail = monitored.sensor->getSampleTail();
+        if (tail > cursor)
+            metrics_.addDropped(tail - cursor);
+        monitored.cursor = std::max(cursor, tail);
+    };
+    skip(monitored.cursor);
+    while (monitored.cursor < monitored.sensor->getSampleHead())
+    {
+        if (monitored.sensor->readSample(monitored.cursor, monitored.next))
         {
-            Logger::log(Logger::Level::Error, "[Fdir] Sensor " + name + " did not provide any output for three consecutive nominal measurement intervals");
+            monitored.has_next = true;
+            return true;
         }
+        metrics_.addDropped();
+        skip(monitored.cursor + 1);
+    }
+    monitored.has_next = false;
+    return false;
+}
+
+// Median of the group values from a bounded set of voters with recent data (lock held)
+std::optional<std::array<double, 3>> Fdir::groupMedian(const Group& group, std::size_t& units)
+{
+    const std::size_t* slots = group.slots.data();
+    const std::size_t count = group.slots.size();
+    // Voters: at most max_voters units spread over the group, whose last sample is within three
+    // nominal intervals of the newest sample of the group
+    units = 0;
+    const std::size_t stride = (count + max_voters - 1) / max_voters;
+    std::int64_t newest_ns = 0;
+    for (std::size_t i = 0; i < count; i += stride)
+        newest_ns = std::max(newest_ns, sensors_[slots[i]].last_ns);
+    std::array<std::size_t, max_voters> voters;
+    for (std::size_t i = 0; i < count; i += stride)
+    {
+        const MonitoredSensor& monitored = sensors_[slots[i]];
+        if (monitored.last_ns != 0 && newest_ns - monitored.last_ns <= missed_intervals * monitored.period_ns)
+            voters[units++] = slots[i];
     }
+    if (units < 2)
+        return std::nullopt;
+
+    std::array<double, 3> median{};
+    for (std::size_t axis = 0; axis < 3; axis++)
+    {
+        std::array<double, max_voters> values;
+        for (std::size_t i = 0; i < units; i++)
+            values[i] = sensors_[voters[i]].last_values[axis];
+
+        // Partial selection: upper middle value, and the largest value below it for an even count
+        double* middle = values.data() + units / 2;
+        std::nth_element(values.data(), middle, values.data() + units);
+        median[axis] = units % 2 == 1 ? *middle : (*std::max_element(values.data(), middle) + *middle) / 2.0;
+    }
+    return median;
 }
 
 // Check the processing unit status
 void Fdir::checkProcessingUnit() 
 {
-    if (!processing_unit_->getLastOutput().valid_imu || !processing_unit_->getLastOutput().valid_gnss) 
+    // Newest output published since the last check, read in place from the bus
+    std::optional<bool> valid;
+    output_subscription_->poll([&valid](const ProcessingOutput& output) { valid = output.valid_imu && output.valid_gnss; });
+    if (!valid)
+        return; // No new output
+
+    if (!*valid) 
     {
         if (!valid_data_) 
         {
             Logger::log(Logger::Level::Error, "[Fdir] Processing unit has invalid data.");
             valid_data_ = true; // Set the flag to true to avoid multiple messages
+            std::lock_guard<std::mutex> lock(fdir_mutex_);
+            detections_.invalid_output++;
+            publishAlarm(FdirAlarmKind::InvalidOutput, true, "processing_unit", nowNs());
         }
     }
     else 
@@ -112,6 +516,37 @@ void Fdir::checkProcessingUnit()
         {
             Logger::log(Logger::Level::Info, "[Fdir] Processing unit has valid data.");
             valid_data_ = false; // Reset the flag when data is valid
+            publishAlarm(FdirAlarmKind::InvalidOutput, false, "processing_unit", nowNs());
         }
     }
-}
\ No newline at end of file
+}
+
+// Publish an alarm on fdir/alarms (FDIR loop only)
+void Fdir::publishAlarm(FdirAlarmKind kind, bool active, const std::string& source, std::int64_t now)
+{
+    FdirAlarm alarm{now, kind, active, {}};
+    source.copy(alarm.source, sizeof(alarm.source) - 1);
+    alarm_topic_->publish(alarm);
+}
+
+// Frequency from the registered sensors, if not fixed (lock held)
+void Fdir::updateFrequency()
+{
+    if (!derived_frequency_)
+        return;
+
+    // Lowest sensor frequency: the longest nominal interval
+    std::int64_t longest_period = 0;
+    for (const MonitoredSensor& monitored : sensors_)
+    {
+        if (monitored.sensor)
+            longest_period = std::max(longest_period, monitored.period_ns);
+    }
+    frequency_ = longest_period > 0 ? 1e9 / static_cast<double>(longest_period) : 1.0;
+}
+
+// Push the failure deadline of a slot (lock held)
+void Fdir::schedule(std::size_t slot, std::int64_t deadline_ns)
+{
+    deadlines_.push({deadline_ns, slot, sensors_[slot].generation});
+}
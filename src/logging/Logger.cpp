@@ -1,54 +1,221 @@
 #include "Logger.hpp"
 #include <filesystem>
+#include <iomanip>
+#include <sstream>
+#include <cstdlib>
 
 std::string Logger::filename_;
 std::ofstream Logger::logfile_;
 std::mutex Logger::log_mutex_;
+Logger::Config Logger::config_;
+std::unique_ptr<MpscQueue<Logger::Record>> Logger::queue_;
+std::thread Logger::writer_;
+std::atomic<bool> Logger::running_{false};
+std::atomic<bool> Logger::writer_idle_{false};
+std::mutex Logger::wake_mutex_;
+std::condition_variable Logger::wake_;
+std::atomic<std::uint64_t> Logger::dropped_{0};
 
 void Logger::init() {
+    init(Config());
+}
+
+void Logger::init(const Config& config) {
+    // Restart cleanly if already initialized
+    shutdown();
+    config_ = config;
+
     // Retrieve file name
     auto now = std::chrono::system_clock::now();
     std::time_t t = std::chrono::system_clock::to_time_t(now);
     std::tm tm = *std::localtime(&t);
     std::ostringstream oss;
-    oss << "../log/log_" << std::put_time(&tm, "%Y%m%d_%H%M%S") << ".log";
+    oss << config_.directory << "/log_" << std::put_time(&tm, "%Y%m%d_%H%M%S") << ".log";
     filename_ = oss.str();
 
     // Ensure the log directory exists
-    std::filesystem::create_directories("../log");
+    std::filesystem::create_directories(config_.directory);
 
     // Open the log file in append mode
     logfile_.open(filename_, std::ios::out | std::ios::app); // Append mode
+
+    // Start the background writer
+    if (config_.asynchronous) {
+        queue_ = std::make_unique<MpscQueue<Record>>(config_.queue_capacity);
+        running_ = true;
+        writer_ = std::thread(&Logger::writerLoop);
+
+        // Make sure queued messages are written if the program exits without shutdown()
+        static bool registered = false;
+        if (!registered) {
+            std::atexit(&Logger::shutdown);
+            registered = true;
+        }
+    }
+}
+
+void Logger::shutdown() {
+    if (running_.exchange(false)) {
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex_);
+        }
+        wake_.notify_one();
+
+        // The writer drains the queue before exiting
+        if (writer_.joinable())
+            writer_.join();
+    }
+
+    std::lock_guard<std::mutex> lock(log_mutex_);
+    if (dropped_ > 0 && logfile_.is_open()) {
+        logfile_ << "[WARNING] - [Logger] " << dropped_ << " messages dropped (queue full)\n";
+        dropped_ = 0;
+    }
+    if (logfile_.is_open())
+        logfile_.flush();
+}
+
+void Logger::log(Level level, std::string_view message) {
+    // No writer thread: write synchronously
+    if (!running_) {
+        writeSync(level, message);
+        return;
+    }
+
+    Record record;
+    record.level = level;
+    record.assign(message);
+    while (!queue_->tryPush(std::move(record))) {
+        if (config_.overflow_policy == OverflowPolicy::Drop) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        std::this_thread::yield(); // Block until the writer makes room
+    }
+
+    // Wake the writer only if it is waiting. The fences pair with the writer's: either the writer
+    // sees this record before sleeping or this producer sees it idle. Taking the mutex makes sure an
+    // idle writer is already waiting (not between its check and its wait) when notified.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (writer_idle_.load(std::memory_order_relaxed)) {
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex_);
+        }
+        wake_.notify_one();
+    }
 }
 
-void Logger::log(Level level, const std::string& message) {
+void Logger::writeSync(Level level, std::string_view message) {
     std::lock_guard<std::mutex> lock(log_mutex_);
 
     // Open the log file if it is not already open
-    if (!logfile_.is_open()) {
+    if (!logfile_.is_open() && !filename_.empty()) {
         logfile_.open(filename_, std::ios::out | std::ios::app); // Append mode
     }
 
-    switch (level) {
+    Record record;
+    record.level = level;
+    record.assign(message);
+    std::string line;
+    format(line, record);
+    logfile_ << line;
+    logfile_.flush(); // Ensure the message is written immediately
+    if (!config_.console)
+        return;
+    if (level == Level::Error)
+        std::cerr << line << std::flush;
+    else
+        std::cout << line << std::flush;
+}
+
+void Logger::format(std::string& buffer, const Record& record) {
+    switch (record.level) {
         case Level::Debug:
-            logfile_ << "[DEBUG] - " << message << std::endl;
-            logfile_.flush(); // Ensure the debug message is written immediately
-            std::cout << "[DEBUG] - " << message << std::endl;
+            buffer += "[DEBUG] - ";
             break;
         case Level::Info:
-            logfile_ << "[INFO] - " << message << std::endl;
-            logfile_.flush(); // Ensure the info is written immediately
-            std::cout << "[INFO] - " << message << std::endl;
+            buffer += "[INFO] - ";
             break;
         case Level::Warning:
-            logfile_ << "[WARNING] - " << message << std::endl;
-            logfile_.flush(); // Ensure the warning is written immediately
-            std::cout << "[WARNING] - " << message << std::endl;
+            buffer += "[WARNING] - ";
             break;
         case Level::Error:
-            logfile_ << "[ERROR] - " << message << std::endl;
-            logfile_.flush(); // Ensure the error is written immediately
-            std::cerr << "[ERROR] - " << message << std::endl;
+            buffer += "[ERROR] - ";
             break;
     }
-}
\ No newline at end of file
+    buffer += record.message();
+    buffer += '\n';
+}
+
+void Logger::Record::assign(std::string_view message) {
+    if (message.size() <= inline_capacity) {
+        message.copy(text, message.size());
+        length = static_cast<std::uint32_t>(message.size());
+        overflow.clear();
+    } else {
+        length = 0;
+        overflow.assign(message);
+    }
+}
+
+void Logger::writerLoop() {
+    std::string file_batch;
+    std::string out_batch;
+    std::string err_batch;
+    auto last_flush = std::chrono::steady_clock::now();
+    Record record;
+
+    while (true) {
+        // Once stopping, drain everything that is left
+        const bool stopping = !running_;
+
+        // Drain up to one batch of messages
+        std::size_t count = 0;
+        while ((stopping || count < config_.batch_size) && queue_->tryPop(record)) {
+            const std::size_t begin = file_batch.size();
+            format(file_batch, record);
+            if (config_.console)
+                (record.level == Level::Error ? err_batch : out_batch).append(file_batch, begin, std::string::npos);
+            count++;
+        }
+
+        // One write per stream per batch
+        if (count > 0) {
+            std::lock_guard<std::mutex> lock(log_mutex_);
+            logfile_.write(file_batch.data(), file_batch.size());
+            if (!out_batch.empty())
+                std::cout.write(out_batch.data(), out_batch.size()).flush();
+            if (!err_batch.empty())
+                std::cerr.write(err_batch.data(), err_batch.size());
+            file_batch.clear();
+            out_batch.clear();
+            err_batch.clear();
+        }
+
+        // Flush the file at the configured interval
+        auto now = std::chrono::steady_clock::now();
+        if (now - last_flush >= config_.flush_interval) {
+            std::lock_guard<std::mutex> lock(log_mutex_);
+            logfile_.flush();
+            last_flush = now;
+        }
+
+        if (stopping)
+            break;
+        if (count == config_.batch_size)
+            continue; // More messages are probably waiting
+
+        // Sleep until a producer wakes us up or the flush interval expires
+        std::unique_lock<std::mutex> lock(wake_mutex_);
+        if (!running_)
+            continue;
+        writer_idle_.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        wake_.wait_for(lock, config_.flush_interval, [] { return !running_ || queue_->size() > 0; });
+        writer_idle_.store(false, std::memory_order_relaxed);
+    }
+
+    std::lock_guard<std::mutex> lock(log_mutex_);
+    logfile_.flush();
+    std::cout.flush();
+}
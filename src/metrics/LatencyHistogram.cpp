@@ -0,0 +1,123 @@
+#include "LatencyHistogram.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <utility>
+
+namespace
+{
+    // Source of the tracker ids (never reused, so a cache entry of a destroyed tracker never matches)
+    std::atomic<std::uint64_t> next_tracker_id{1};
+
+    // Value of the rank-th smallest recorded value (rank from 1) in merged counts
+    double percentile(const std::vector<std::uint64_t>& counts, std::uint64_t rank, std::uint64_t max)
+    {
+        std::uint64_t seen = 0;
+        for (std::size_t bucket = 0; bucket < counts.size(); bucket++)
+        {
+            seen += counts[bucket];
+            if (seen >= rank)
+                return std::min(LatencyHistogram::valueOf(bucket), static_cast<double>(max));
+        }
+        return static_cast<double>(max);
+    }
+}
+
+// Format as "n=..., p50 ... us, p99 ... us, p99.9 ... us, max ... us"
+std::string LatencySummary::format() const
+{
+    char text[160];
+    std::snprintf(text, sizeof(text), "n=%llu, p50 %.1f us, p99 %.1f us, p99.9 %.1f us, max %.1f us",
+        static_cast<unsigned long long>(count), p50_us, p99_us, p999_us, max_us);
+    return text;
+}
+
+// Add the counts to a merge buffer of bucket_count entries, and the maximum
+void LatencyHistogram::mergeInto(std::vector<std::uint64_t>& counts, std::uint64_t& max) const
+{
+    for (std::size_t bucket = 0; bucket < bucket_count; bucket++)
+        counts[bucket] += counts_[bucket].load(std::memory_order_relaxed);
+    max = std::max(max, max_.load(std::memory_order_relaxed));
+}
+
+// Clear the counts (the writer must be idle)
+void LatencyHistogram::reset()
+{
+    for (auto& count : counts_)
+        count.store(0, std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+}
+
+// Middle of the value range of a bucket
+double LatencyHistogram::valueOf(std::size_t bucket)
+{
+    if (bucket < sub_buckets)
+        return static_cast<double>(bucket);
+    const unsigned shift = static_cast<unsigned>(bucket / sub_buckets) - 1;
+    const double lower = std::ldexp(static_cast<double>(bucket % sub_buckets + sub_buckets), static_cast<int>(shift));
+    return lower + std::ldexp(0.5, static_cast<int>(shift));
+}
+
+// Constructor
+LatencyTracker::LatencyTracker(std::string name) : id_(next_tracker_id++), name_(std::move(name))
+{
+}
+
+// Record one latency in ns (calling thread's histogram)
+void LatencyTracker::record(std::int64_t latency_ns)
+{
+    local().record(latency_ns);
+}
+
+// Histogram of the calling thread (created on its first record)
+LatencyHistogram& LatencyTracker::local()
+{
+    // Few trackers per thread: a linear scan of a small vector is the fastest lookup
+    thread_local std::vector<std::pair<std::uint64_t, LatencyHistogram*>> cache;
+    for (const auto& [id, histogram] : cache)
+    {
+        if (id == id_)
+            return *histogram;
+    }
+
+    std::lock_guard<std::mutex> lock(shards_mutex_);
+    shards_.push_back(std::make_unique<LatencyHistogram>());
+    cache.emplace_back(id_, shards_.back().get());
+    return *shards_.back();
+}
+
+// Merge the per-thread histograms into percentiles
+LatencySummary LatencyTracker::summary() const
+{
+    std::vector<std::uint64_t> counts(LatencyHistogram::bucket_count, 0);
+    std::uint64_t max = 0;
+    {
+        std::lock_guard<std::mutex> lock(shards_mutex_);
+        for (const auto& shard : shards_)
+            shard->mergeInto(counts, max);
+    }
+
+    LatencySummary summary;
+    for (std::uint64_t count : counts)
+        summary.count += count;
+    if (summary.count == 0)
+        return summary;
+
+    auto at = [&](double quantile) {
+        const auto rank = static_cast<std::uint64_t>(std::ceil(quantile * static_cast<double>(summary.count)));
+        return percentile(counts, std::max<std::uint64_t>(rank, 1), max) / 1e3;
+    };
+    summary.p50_us = at(0.5);
+    summary.p99_us = at(0.99);
+    summary.p999_us = at(0.999);
+    summary.max_us = static_cast<double>(max) / 1e3;
+    return summary;
+}
+
+// Clear every histogram (the writers must be idle, e.g. before a start)
+void LatencyTracker::reset()
+{
+    std::lock_guard<std::mutex> lock(shards_mutex_);
+    for (auto& shard : shards_)
+        shard->reset();
+}
@@ -0,0 +1,183 @@
+#include "MetricsRegistry.hpp"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include "../logging/Logger.hpp"
+
+namespace
+{
+    // Metric family: name, help, type and the value of one component (false = not reported)
+    struct Family
+    {
+        const char* name;
+        const char* help;
+        const char* type;
+        std::function<bool(const MetricsSource&, const ComponentMetrics::Snapshot&, const TimingStats&, double&)> value;
+    };
+
+    double seconds(std::uint64_t ns) { return static_cast<double>(ns) / 1e9; }
+}
+
+// Destructor: stop the exporter
+MetricsRegistry::~MetricsRegistry()
+{
+    stopExport();
+}
+
+// Register a component (before startExport())
+void MetricsRegistry::add(MetricsSource source)
+{
+    sources_.push_back(std::move(source));
+}
+
+// Register families rendered by their owner (before startExport())
+void MetricsRegistry::addFamilies(std::function<std::string()> render)
+{
+    renderers_.push_back(std::move(render));
+}
+
+// Snapshot of every metric in the Prometheus text exposition format
+std::string MetricsRegistry::prometheus() const
+{
+    // Read every component once, so that the families of one snapshot agree
+    std::vector<ComponentMetrics::Snapshot> counters(sources_.size());
+    std::vector<TimingStats> timings(sources_.size());
+    for (std::size_t i = 0; i < sources_.size(); i++)
+    {
+        if (sources_[i].counters)
+            counters[i] = sources_[i].counters->snapshot();
+        if (sources_[i].timing)
+            timings[i] = sources_[i].timing();
+    }
+
+    const Family families[] = {
+        {"sensors_ticks_total", "Loop iterations", "counter",
+            [](const MetricsSource& s, const ComponentMetrics::Snapshot& c, const TimingStats&, double& v) { v = static_cast<double>(c.ticks); return s.counters != nullptr; }},
+        {"sensors_tick_duration_seconds_total", "Time spent in the loop iterations", "counter",
+            [](const MetricsSource& s, const ComponentMetrics::Snapshot& c, const TimingStats&, double& v) { v = seconds(c.tick_ns_total); return s.counters != nullptr; }},
+        {"sensors_tick_duration_seconds_max", "Longest loop iteration", "gauge",
+            [](const MetricsSource& s, const ComponentMetrics::Snapshot& c, const TimingStats&, double& v) { v = seconds(c.tick_ns_max); return s.counters != nullptr; }},
+        {"sensors_deadline_overruns_total", "Activation periods longer than 1.5 nominal periods", "counter",
+            [](const MetricsSource& s, const ComponentMetrics::Snapshot&, const TimingStats& t, double& v) { v = static_cast<double>(t.overruns); return static_cast<bool>(s.timing); }},
+        {"sensors_activation_jitter_seconds", "Standard deviation of the activation period", "gauge",
+            [](const MetricsSource& s, const ComponentMetrics::Snapshot&, const TimingStats& t, double& v) { v = t.jitter_ns / 1e9; return static_cast<bool>(s.timing); }},
+        {"sensors_samples_produced_total", "Samples or outputs produced (checked, for FDIR)", "counter",
+            [](const MetricsSource& s, const ComponentMetrics::Snapshot& c, const TimingStats&, double& v) { v = static_cast<double>(c.produced); return s.counters != nullptr; }},
+        {"sensors_samples_dropped_total", "Samples or outputs lost", "counter",
+            [](const MetricsSource& s, const ComponentMetrics::Snapshot& c, const TimingStats&, double& v) {
+                v = static_cast<double>(c.dropped + (s.dropped ? s.dropped() : 0));
+                return s.counters != nullptr || static_cast<bool>(s.dropped); }},
+        {"sensors_buffer_occupancy", "Entries in the buffer or queue", "gauge",
+            [](const MetricsSource& s, const ComponentMetrics::Snapshot&, const TimingStats&, double& v) {
+                if (!s.buffer) return false;
+                v = static_cast<double>(s.buffer().first); return true; }},
+        {"sensors_buffer_capacity", "Capacity of the buffer or queue", "gauge",
+            [](const MetricsSource& s, const ComponentMetrics::Snapshot&, const TimingStats&, double& v) {
+                if (!s.buffer) return false;
+                v = static_cast<double>(s.buffer().second); return true; }},
+        {"sensors_lock_acquisitions_total", "Acquisitions of the metered mutex", "counter",
+            [](const MetricsSource& s, const ComponentMetrics::Snapshot& c, const TimingStats&, double& v) { v = static_cast<double>(c.lock_acquisitions); return !s.lock.empty(); }},
+        {"sensors_lock_contended_total", "Acquisitions of the metered mutex that had to wait", "counter",
+            [](const MetricsSource& s, const ComponentMetrics::Snapshot& c, const TimingStats&, double& v) { v = static_cast<double>(c.lock_contended); return !s.lock.empty(); }},
+        {"sensors_lock_wait_seconds_total", "Time spent waiting for the metered mutex", "counter",
+            [](const MetricsSource& s, const ComponentMetrics::Snapshot& c, const TimingStats&, double& v) { v = seconds(c.lock_wait_ns_total); return !s.lock.empty(); }},
+        {"sensors_lock_wait_seconds_max", "Longest wait for the metered mutex", "gauge",
+            [](const MetricsSource& s, const ComponentMetrics::Snapshot& c, const TimingStats&, double& v) { v = seconds(c.lock_wait_ns_max); return !s.lock.empty(); }},
+    };
+
+    std::string text;
+    char line[256];
+    for (const Family& family : families)
+    {
+        bool header = false;
+        for (std::size_t i = 0; i < sources_.size(); i++)
+        {
+            const MetricsSource& source = sources_[i];
+            double value = 0.0;
+            if (!family.value(source, counters[i], timings[i], value))
+                continue;
+            if (!header)
+            {
+                text += std::string("# HELP ") + family.name + " " + family.help + "\n";
+                text += std::string("# TYPE ") + family.name + " " + family.type + "\n";
+                header = true;
+            }
+            const bool lock_family = std::string(family.name).compare(0, 13, "sensors_lock_") == 0;
+            const std::string lock = lock_family ? ",lock=\"" + source.lock + "\"" : "";
+            std::snprintf(line, sizeof(line), "%s{component=\"%s\",kind=\"%s\"%s} %.9g\n",
+                family.name, source.component.c_str(), source.kind.c_str(), lock.c_str(), value);
+            text += line;
+        }
+    }
+    for (const auto& render : renderers_)
+        text += render();
+    return text;
+}
+
+// Write the snapshot to a file every interval, from a dedicated thread
+bool MetricsRegistry::startExport(const std::string& path, std::chrono::milliseconds interval)
+{
+    stopExport();
+    path_ = path;
+    interval_ = interval;
+
+    // No export if the directory cannot be created (the run goes on without it)
+    const std::filesystem::path parent = std::filesystem::path(path_).parent_path();
+    std::error_code error;
+    if (!parent.empty())
+        std::filesystem::create_directories(parent, error);
+    if (error)
+    {
+        Logger::log(Logger::Level::Error, "[MetricsRegistry] Cannot create the directory " + parent.string() + ": " + error.message() + ", no metrics export");
+        return false;
+    }
+
+    exporting_ = true;
+    thread_ = std::thread(&MetricsRegistry::exportLoop, this);
+    return true;
+}
+
+// Stop the exporter thread, writing a last snapshot
+void MetricsRegistry::stopExport()
+{
+    {
+        std::lock_guard<std::mutex> lock(export_mutex_);
+        if (!exporting_)
+            return;
+        exporting_ = false;
+    }
+    wake_.notify_one();
+    if (thread_.joinable())
+        thread_.join();
+    writeSnapshot();
+}
+
+// Exporter thread loop
+void MetricsRegistry::exportLoop()
+{
+    std::unique_lock<std::mutex> lock(export_mutex_);
+    while (exporting_)
+    {
+        lock.unlock();
+        writeSnapshot();
+        lock.lock();
+        wake_.wait_for(lock, interval_, [this] { return !exporting_; });
+    }
+}
+
+// Write the snapshot file
+bool MetricsRegistry::writeSnapshot() const
+{
+    const std::string temporary = path_ + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::out | std::ios::trunc);
+        if (!file)
+            return false;
+        file << prometheus();
+        if (!file)
+            return false;
+    }
+    std::error_code error;
+    std::filesystem::rename(temporary, path_, error);
+    return !error;
+}
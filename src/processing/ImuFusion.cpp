@@ -0,0 +1,136 @@
+#include "ImuFusion.hpp"
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+namespace
+{
+    // Interpolate a window at dt = 0. Fixed trip count and no branches, so the compiler vectorizes it:
+    // every segment [dt[k], dt[k+1]) contributes its linear interpolation times 1 if it contains 0, else 0.
+    // The sentinel after the newest sample (dt = +inf) holds the newest value after it,
+    // and the oldest value is held before the first sample.
+    double interpolate(const double* dt, const double* values)
+    {
+        double contribution[ImuFusion::window];
+#pragma GCC unroll 1 // Keep the loop for the vectorizer (a full unroll leaves scalar code)
+        for (std::size_t k = 0; k < ImuFusion::window; k++)
+        {
+            const double span = std::max(dt[k + 1] - dt[k], 1.0);   // Padded samples have a zero span
+            const double alpha = -dt[k] / span;
+            const double inside = (dt[k] <= 0.0 && dt[k + 1] > 0.0) ? 1.0 : 0.0;
+            contribution[k] = inside * (values[k] + alpha * (values[k + 1] - values[k]));
+        }
+
+        double result = dt[0] > 0.0 ? values[0] : 0.0;
+        for (double value : contribution)
+            result += value;
+        return result;
+    }
+}
+
+// Constructor: storage for the given IMUs is allocated once
+ImuFusion::ImuFusion(std::vector<std::shared_ptr<ImuSensor>> imu_sensors)
+    : imu_sensors_(std::move(imu_sensors)), windows_(imu_sensors_.size())
+{
+    snapshot_.resize(imu_sensors_.size());
+}
+
+// Fuse the IMUs with valid data; nullopt when there is none
+std::optional<ImuFusion::Result> ImuFusion::fuse()
+{
+    // Copy the recent history of the IMUs whose latest sample is valid
+    std::optional<Sensor::Timestamp> newest;
+    for (std::size_t i = 0; i < imu_sensors_.size(); i++)
+    {
+        Window& window = windows_[i];
+        window.active = imu_sensors_[i]->getLatest().has_value();
+        if (window.active)
+            load(*imu_sensors_[i], window);
+        window.active = window.active && window.count > 0;
+        if (window.active && (!newest || window.timestamps[ImuFusion::window - 1] > *newest))
+            newest = window.timestamps[ImuFusion::window - 1];
+    }
+    if (!newest)
+        return std::nullopt;
+
+    // Fusion timestamp: oldest latest sample among the IMUs that are not stale
+    // (an IMU lagging more than three nominal periods would hold the others back)
+    Sensor::Timestamp fusion_time = *newest;
+    for (std::size_t i = 0; i < imu_sensors_.size(); i++)
+    {
+        Window& window = windows_[i];
+        if (!window.active)
+            continue;
+
+        const auto lag = *newest - window.timestamps[ImuFusion::window - 1];
+        const auto max_lag = std::chrono::duration<double>(3.0 / imu_sensors_[i]->getFrequency());
+        if (lag > max_lag)
+            window.active = false;
+        else
+            fusion_time = std::min(fusion_time, window.timestamps[ImuFusion::window - 1]);
+    }
+
+    // Resample every IMU at the fusion timestamp
+    for (std::size_t i = 0; i < windows_.size(); i++)
+    {
+        Window& window = windows_[i];
+        if (!window.active)
+        {
+            snapshot_.invalidate(i);
+            continue;
+        }
+
+        for (std::size_t k = 0; k < ImuFusion::window; k++)
+            window.dt[k] = static_cast<double>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(window.timestamps[k] - fusion_time).count());
+        window.dt[ImuFusion::window] = std::numeric_limits<double>::infinity();
+        snapshot_.set(i,
+            interpolate(window.dt, window.values[0]),
+            interpolate(window.dt, window.values[1]),
+            interpolate(window.dt, window.values[2]));
+    }
+
+    // Masked mean and variance over the resampled IMUs
+    const ImuStatistics statistics = fuseImuSnapshot(snapshot_, true);
+    return Result{fusion_time, statistics.mean, statistics.variance, statistics.count};
+}
+
+// Copy the last samples of an IMU into its window (padding in front to the fixed size)
+void ImuFusion::load(const ImuSensor& imu, Window& window)
+{
+    // Copy from the ring buffer (checked copies, never torn), oldest first
+    std::size_t count = 0;
+    imu.getBuffer().forEachLatest(ImuFusion::window, [&](const ImuData& sample) {
+        if (count == ImuFusion::window)
+            return;
+        window.timestamps[count] = sample.timestamp;
+        window.values[0][count] = sample.att_rate_x;
+        window.values[1][count] = sample.att_rate_y;
+        window.values[2][count] = sample.att_rate_z;
+        count++;
+    });
+    window.count = count;
+    if (count == 0)
+        return;
+
+    // Sentinel after the newest sample
+    for (std::size_t axis = 0; axis < 3; axis++)
+        window.values[axis][ImuFusion::window] = window.values[axis][count - 1];
+    if (count == ImuFusion::window)
+        return;
+
+    // Right-align the samples and repeat the oldest one in front (zero-length segments)
+    const std::size_t pad = ImuFusion::window - count;
+    for (std::size_t k = ImuFusion::window; k-- > pad;)
+    {
+        window.timestamps[k] = window.timestamps[k - pad];
+        for (std::size_t axis = 0; axis < 3; axis++)
+            window.values[axis][k] = window.values[axis][k - pad];
+    }
+    for (std::size_t k = 0; k < pad; k++)
+    {
+        window.timestamps[k] = window.timestamps[pad];
+        for (std::size_t axis = 0; axis < 3; axis++)
+            window.values[axis][k] = window.values[axis][pad];
+    }
+}
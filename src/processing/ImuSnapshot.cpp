@@ -0,0 +1,212 @@
+#include "ImuSnapshot.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define IMU_SNAPSHOT_X86 1
+#endif
+
+namespace
+{
+    // Per-axis sums of (value - shift) and (value - shift)^2 over the valid channels.
+    // Shifting by one valid value keeps the one-pass variance accurate when |mean| >> stddev.
+    struct Sums
+    {
+        double sum[3];
+        double sum_squares[3];
+    };
+
+    // Number of valid channels
+    std::size_t countValid(const ImuSnapshot& snapshot)
+    {
+        std::size_t count = 0;
+        for (std::uint64_t word : snapshot.valid)
+            count += static_cast<std::size_t>(__builtin_popcountll(word));
+        return count;
+    }
+
+    // Values of the first valid channel (used as shift)
+    std::array<double, 3> firstValid(const ImuSnapshot& snapshot)
+    {
+        for (std::size_t word = 0; word < snapshot.valid.size(); word++)
+        {
+            if (snapshot.valid[word] != 0)
+            {
+                const std::size_t channel = word * 64 + static_cast<std::size_t>(__builtin_ctzll(snapshot.valid[word]));
+                return {snapshot.x[channel], snapshot.y[channel], snapshot.z[channel]};
+            }
+        }
+        return {0.0, 0.0, 0.0};
+    }
+
+    // Mean and variance from the shifted sums
+    ImuStatistics finish(const Sums& sums, const std::array<double, 3>& shift, std::size_t count, bool with_variance)
+    {
+        ImuStatistics statistics{{0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}, count};
+        if (count == 0)
+            return statistics;
+
+        const double n = static_cast<double>(count);
+        for (std::size_t axis = 0; axis < 3; axis++)
+        {
+            statistics.mean[axis] = shift[axis] + sums.sum[axis] / n;
+            if (with_variance && count > 1)
+            {
+                const double variance = (sums.sum_squares[axis] - sums.sum[axis] * sums.sum[axis] / n) / (n - 1.0);
+                statistics.variance[axis] = variance > 0.0 ? variance : 0.0;
+            }
+        }
+        return statistics;
+    }
+
+    // Scalar kernel
+    Sums sumScalar(const ImuSnapshot& snapshot, const std::array<double, 3>& shift, bool with_variance)
+    {
+        Sums sums{{0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}};
+        const double* axes[3] = {snapshot.x.data(), snapshot.y.data(), snapshot.z.data()};
+        for (std::size_t channel = 0; channel < snapshot.channels; channel++)
+        {
+            if (!((snapshot.valid[channel / 64] >> (channel % 64)) & 1))
+                continue;
+
+            for (std::size_t axis = 0; axis < 3; axis++)
+            {
+                const double delta = axes[axis][channel] - shift[axis];
+                sums.sum[axis] += delta;
+                if (with_variance)
+                    sums.sum_squares[axis] += delta * delta;
+            }
+        }
+        return sums;
+    }
+
+#ifdef IMU_SNAPSHOT_X86
+    // SSE2 kernel: 2 x 2 channels per step (two accumulators hide the add latency),
+    // lane masks from a lookup table (SSE2 has no 64-bit compare)
+    Sums sumSse2(const ImuSnapshot& snapshot, const std::array<double, 3>& shift, bool with_variance)
+    {
+        alignas(16) static const std::uint64_t masks[4][2] = {
+            {0, 0}, {~std::uint64_t(0), 0}, {0, ~std::uint64_t(0)}, {~std::uint64_t(0), ~std::uint64_t(0)}
+        };
+        const double* axes[3] = {snapshot.x.data(), snapshot.y.data(), snapshot.z.data()};
+        const std::size_t padded = snapshot.x.size();
+
+        Sums sums{{0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}};
+        for (std::size_t axis = 0; axis < 3; axis++)
+        {
+            const __m128d offset = _mm_set1_pd(shift[axis]);
+            __m128d sum = _mm_setzero_pd(), sum_odd = _mm_setzero_pd();
+            __m128d sum_squares = _mm_setzero_pd(), sum_squares_odd = _mm_setzero_pd();
+            for (std::size_t channel = 0; channel < padded; channel += 4)
+            {
+                const unsigned bits = static_cast<unsigned>((snapshot.valid[channel / 64] >> (channel % 64)) & 15);
+                const __m128d mask = _mm_load_pd(reinterpret_cast<const double*>(masks[bits & 3]));
+                const __m128d mask_odd = _mm_load_pd(reinterpret_cast<const double*>(masks[bits >> 2]));
+                const __m128d delta = _mm_and_pd(mask, _mm_sub_pd(_mm_loadu_pd(axes[axis] + channel), offset));
+                const __m128d delta_odd = _mm_and_pd(mask_odd, _mm_sub_pd(_mm_loadu_pd(axes[axis] + channel + 2), offset));
+                sum = _mm_add_pd(sum, delta);
+                sum_odd = _mm_add_pd(sum_odd, delta_odd);
+                sum_squares = _mm_add_pd(sum_squares, _mm_mul_pd(delta, delta));
+                sum_squares_odd = _mm_add_pd(sum_squares_odd, _mm_mul_pd(delta_odd, delta_odd));
+            }
+            sum = _mm_add_pd(sum, sum_odd);
+            sum_squares = _mm_add_pd(sum_squares, sum_squares_odd);
+
+            alignas(16) double lanes[2];
+            _mm_store_pd(lanes, sum);
+            sums.sum[axis] = lanes[0] + lanes[1];
+            if (with_variance)
+            {
+                _mm_store_pd(lanes, sum_squares);
+                sums.sum_squares[axis] = lanes[0] + lanes[1];
+            }
+        }
+        return sums;
+    }
+
+    // AVX2 kernel: 2 x 4 channels per step (two accumulators hide the add latency),
+    // lane masks from the validity bits with a 64-bit compare
+    __attribute__((target("avx2")))
+    Sums sumAvx2(const ImuSnapshot& snapshot, const std::array<double, 3>& shift, bool with_variance)
+    {
+        const __m256i lane_bits = _mm256_set_epi64x(8, 4, 2, 1);
+        const double* axes[3] = {snapshot.x.data(), snapshot.y.data(), snapshot.z.data()};
+        const std::size_t padded = snapshot.x.size();
+
+        Sums sums{{0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}};
+        for (std::size_t axis = 0; axis < 3; axis++)
+        {
+            const __m256d offset = _mm256_set1_pd(shift[axis]);
+            __m256d sum = _mm256_setzero_pd(), sum_odd = _mm256_setzero_pd();
+            __m256d sum_squares = _mm256_setzero_pd(), sum_squares_odd = _mm256_setzero_pd();
+            for (std::size_t channel = 0; channel < padded; channel += 8)
+            {
+                const long long bits = static_cast<long long>((snapshot.valid[channel / 64] >> (channel % 64)) & 255);
+                const __m256i selected = _mm256_and_si256(_mm256_set1_epi64x(bits & 15), lane_bits);
+                const __m256i selected_odd = _mm256_and_si256(_mm256_set1_epi64x(bits >> 4), lane_bits);
+                const __m256d mask = _mm256_castsi256_pd(_mm256_cmpeq_epi64(selected, lane_bits));
+                const __m256d mask_odd = _mm256_castsi256_pd(_mm256_cmpeq_epi64(selected_odd, lane_bits));
+                const __m256d delta = _mm256_and_pd(mask, _mm256_sub_pd(_mm256_loadu_pd(axes[axis] + channel), offset));
+                const __m256d delta_odd = _mm256_and_pd(mask_odd, _mm256_sub_pd(_mm256_loadu_pd(axes[axis] + channel + 4), offset));
+                sum = _mm256_add_pd(sum, delta);
+                sum_odd = _mm256_add_pd(sum_odd, delta_odd);
+                sum_squares = _mm256_add_pd(sum_squares, _mm256_mul_pd(delta, delta));
+                sum_squares_odd = _mm256_add_pd(sum_squares_odd, _mm256_mul_pd(delta_odd, delta_odd));
+            }
+            sum = _mm256_add_pd(sum, sum_odd);
+            sum_squares = _mm256_add_pd(sum_squares, sum_squares_odd);
+
+            alignas(32) double lanes[4];
+            _mm256_store_pd(lanes, sum);
+            sums.sum[axis] = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+            if (with_variance)
+            {
+                _mm256_store_pd(lanes, sum_squares);
+                sums.sum_squares[axis] = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+            }
+        }
+        return sums;
+    }
+#endif
+}
+
+// Best instruction set supported by this CPU
+SimdLevel detectSimdLevel()
+{
+#ifdef IMU_SNAPSHOT_X86
+    static const SimdLevel level = __builtin_cpu_supports("avx2") ? SimdLevel::Avx2 : SimdLevel::Sse2;
+    return level;
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+// Masked mean (and variance, in the same pass) of the valid channels, on the best instruction set
+ImuStatistics fuseImuSnapshot(const ImuSnapshot& snapshot, bool with_variance)
+{
+    return fuseImuSnapshot(snapshot, with_variance, detectSimdLevel());
+}
+
+// Same as above on a given instruction set (falls back to scalar if not supported)
+ImuStatistics fuseImuSnapshot(const ImuSnapshot& snapshot, bool with_variance, SimdLevel level)
+{
+    const std::size_t count = countValid(snapshot);
+    const std::array<double, 3> shift = firstValid(snapshot);
+    if (count == 0)
+        return finish(Sums{{0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}}, shift, 0, with_variance);
+
+    // Never run an instruction set the CPU lacks
+    if (level == SimdLevel::Avx2 && detectSimdLevel() != SimdLevel::Avx2)
+        level = detectSimdLevel();
+
+    switch (level)
+    {
+#ifdef IMU_SNAPSHOT_X86
+        case SimdLevel::Avx2:
+            return finish(sumAvx2(snapshot, shift, with_variance), shift, count, with_variance);
+        case SimdLevel::Sse2:
+            return finish(sumSse2(snapshot, shift, with_variance), shift, count, with_variance);
+#endif
+        default:
+            return finish(sumScalar(snapshot, shift, with_variance), shift, count, with_variance);
+    }
+}
@@ -0,0 +1,128 @@
+#include "NavigationFilter.hpp"
+#include <cmath>
+
+namespace
+{
+    // Offsets of the error-state blocks
+    constexpr std::size_t position_block = 0;
+    constexpr std::size_t velocity_block = 3;
+    constexpr std::size_t attitude_block = 6;
+
+    // Hamilton product a * b of quaternions (w, x, y, z)
+    std::array<double, 4> multiply(const std::array<double, 4>& a, const std::array<double, 4>& b)
+    {
+        return {
+            a[0] * b[0] - a[1] * b[1] - a[2] * b[2] - a[3] * b[3],
+            a[0] * b[1] + a[1] * b[0] + a[2] * b[3] - a[3] * b[2],
+            a[0] * b[2] - a[1] * b[3] + a[2] * b[0] + a[3] * b[1],
+            a[0] * b[3] + a[1] * b[2] - a[2] * b[1] + a[3] * b[0]
+        };
+    }
+
+    // Rotate a quaternion by a small rotation vector (body frame) and renormalize
+    std::array<double, 4> rotate(const std::array<double, 4>& attitude, double x, double y, double z)
+    {
+        const double angle = std::sqrt(x * x + y * y + z * z);
+        const double half = 0.5 * angle;
+        const double scale = angle > 1e-12 ? std::sin(half) / angle : 0.5;
+        std::array<double, 4> result = multiply(attitude, {std::cos(half), x * scale, y * scale, z * scale});
+
+        const double norm = std::sqrt(result[0] * result[0] + result[1] * result[1] + result[2] * result[2] + result[3] * result[3]);
+        for (double& component : result)
+            component /= norm;
+        return result;
+    }
+}
+
+// Constructor
+NavigationFilter::NavigationFilter(const NavigationConfig& config) : config_(config) {}
+
+// Start from a first position measurement (zero velocity, level attitude)
+void NavigationFilter::initialize(const std::array<double, 3>& position, double position_noise)
+{
+    position_ = position;
+    velocity_ = {0.0, 0.0, 0.0};
+    attitude_ = {1.0, 0.0, 0.0, 0.0};
+
+    Filter::Covariance covariance;
+    for (std::size_t axis = 0; axis < 3; axis++)
+    {
+        covariance(position_block + axis, position_block + axis) = position_noise * position_noise;
+        covariance(velocity_block + axis, velocity_block + axis) = config_.initial_velocity_sigma * config_.initial_velocity_sigma;
+        covariance(attitude_block + axis, attitude_block + axis) = config_.initial_attitude_sigma * config_.initial_attitude_sigma;
+    }
+    filter_.reset(covariance);
+    initialized_ = true;
+}
+
+// Predict step: propagate over dt seconds with an attitude rate
+void NavigationFilter::predict(const std::array<double, 3>& rate, double dt, double rate_noise)
+{
+    if (!initialized_ || !(dt > 0.0))
+        return;
+
+    // Nominal state
+    for (std::size_t axis = 0; axis < 3; axis++)
+        position_[axis] += velocity_[axis] * dt;
+    const double angle_x = rate[0] * dt, angle_y = rate[1] * dt, angle_z = rate[2] * dt;
+    attitude_ = rotate(attitude_, angle_x, angle_y, angle_z);
+
+    // Error transition: position from velocity, attitude error rotated by -angle (I - [angle]x)
+    Filter::Covariance transition = Filter::Covariance::identity();
+    for (std::size_t axis = 0; axis < 3; axis++)
+        transition(position_block + axis, velocity_block + axis) = dt;
+    transition(attitude_block + 0, attitude_block + 1) = angle_z;
+    transition(attitude_block + 0, attitude_block + 2) = -angle_y;
+    transition(attitude_block + 1, attitude_block + 0) = -angle_z;
+    transition(attitude_block + 1, attitude_block + 2) = angle_x;
+    transition(attitude_block + 2, attitude_block + 0) = angle_y;
+    transition(attitude_block + 2, attitude_block + 1) = -angle_x;
+
+    // Process noise: discrete white acceleration on position/velocity, rate noise integrated over dt
+    const double acceleration = config_.acceleration_noise * config_.acceleration_noise;
+    const double angle_noise = rate_noise * dt;
+    Filter::Covariance process_noise;
+    for (std::size_t axis = 0; axis < 3; axis++)
+    {
+        process_noise(position_block + axis, position_block + axis) = acceleration * dt * dt * dt / 3.0;
+        process_noise(position_block + axis, velocity_block + axis) = acceleration * dt * dt / 2.0;
+        process_noise(velocity_block + axis, position_block + axis) = acceleration * dt * dt / 2.0;
+        process_noise(velocity_block + axis, velocity_block + axis) = acceleration * dt;
+        process_noise(attitude_block + axis, attitude_block + axis) = angle_noise * angle_noise;
+    }
+    filter_.predict(transition, process_noise);
+}
+
+// Update step: correct with a position measurement
+bool NavigationFilter::update(const std::array<double, 3>& position, double position_noise)
+{
+    if (!initialized_)
+    {
+        initialize(position, position_noise);
+        return true;
+    }
+
+    Matrix<3, 1> innovation;
+    Matrix<3, states> observation;
+    Matrix<3, 3> measurement_noise;
+    for (std::size_t axis = 0; axis < 3; axis++)
+    {
+        innovation(axis, 0) = position[axis] - position_[axis];
+        observation(axis, position_block + axis) = 1.0;
+        measurement_noise(axis, axis) = position_noise * position_noise;
+    }
+    const std::optional<Filter::State> correction = filter_.update(innovation, observation, measurement_noise);
+    if (!correction)
+        return false;
+
+    // Fold the error into the nominal state (the error resets to zero; the reset Jacobian is
+    // the identity to first order for small attitude corrections)
+    const Filter::State& error = *correction;
+    for (std::size_t axis = 0; axis < 3; axis++)
+    {
+        position_[axis] += error(position_block + axis, 0);
+        velocity_[axis] += error(velocity_block + axis, 0);
+    }
+    attitude_ = rotate(attitude_, error(attitude_block + 0, 0), error(attitude_block + 1, 0), error(attitude_block + 2, 0));
+    return true;
+}
@@ -1,18 +1,29 @@
 #include "ProcessingUnit.hpp"
-#include <deque>
 #include <optional>
 #include <iostream>
 #include <filesystem>
 #include <chrono>
 #include <iomanip>
 #include <sstream>
+#include <algorithm>
+
+namespace
+{
+    // Outputs kept on the fusion/output topic for the subscribers (about 5 s at 50 Hz)
+    constexpr std::size_t output_topic_capacity = 256;
+}
 
 // Constructor
 ProcessingUnit::ProcessingUnit(
     std::vector<std::shared_ptr<ImuSensor>> imu_sensors, 
     std::vector<std::shared_ptr<GnssSensor>> gnss_sensors, 
-    double frequency
-) : imu_sensors_(imu_sensors), gnss_sensors_(gnss_sensors), frequency_(frequency), running_(true) 
+    double frequency,
+    RecordingFormat recording_format,
+    const FlushPolicy& flush_policy,
+    const std::string& data_root
+) : imu_sensors_(imu_sensors), gnss_sensors_(gnss_sensors), frequency_(frequency), running_(true), imu_fusion_(imu_sensors),
+    output_topic_(std::make_shared<Topic<ProcessingOutput>>("fusion/output", output_topic_capacity)),
+    imu_latency_("imu_to_fusion"), gnss_latency_("gnss_to_fusion")
 {
     // Create timestamp for folder name
     auto now = std::chrono::system_clock::now();
@@ -21,16 +32,17 @@ ProcessingUnit::ProcessingUnit(
     ss << std::put_time(std::localtime(&now_time_t), "%Y%m%d_%H%M%S");
     
     // Create data directory
-    data_directory_ = "../data/" + ss.str() + "_data";
+    data_directory_ = data_root + "/" + ss.str() + "_data";
     std::filesystem::create_directories(data_directory_);
 
-    // Open and initialize CSV files
-    imu_file_.open(data_directory_ + "/imu.csv");
-    gnss_file_.open(data_directory_ + "/gnss.csv");
-
-    // Write headers
-    imu_file_ << "timestamp,attitude_rate_x,attitude_rate_y,attitude_rate_z,valid\n";
-    gnss_file_ << "timestamp,pos_x,pos_y,pos_z,valid\n";
+    // Create the output files (CSV or binary)
+    std::vector<std::string> imu_names;
+    for (auto& imu_sensor : imu_sensors_)
+        imu_names.push_back(imu_sensor->getName());
+    std::vector<std::string> gnss_names;
+    for (auto& gnss_sensor : gnss_sensors_)
+        gnss_names.push_back(gnss_sensor->getName());
+    recorder_ = std::make_unique<Recorder>(data_directory_, recording_format, imu_names, gnss_names, flush_policy);
 }
 
 // Starts the simulation thread
@@ -38,7 +50,48 @@ void ProcessingUnit::start()
 {
     Logger::log(Logger::Level::Info, "[ProcessingUnit] Start");
     running_ = true;
-    thread_ = std::thread(&ProcessingUnit::run, this);
+    recorder_->start();
+    timing_.reset();
+    imu_latency_.reset();
+    gnss_latency_.reset();
+    metrics_.reset();
+
+    // The navigation filter starts over from the samples published from now on
+    if (fusion_engine_ == FusionEngine::Kalman)
+    {
+        navigation_.reset();
+        navigation_time_.reset();
+        imu_cursors_.clear();
+        for (auto& imu_sensor : imu_sensors_)
+            imu_cursors_.push_back(imu_sensor->getSampleHead());
+        gnss_cursors_.clear();
+        for (auto& gnss_sensor : gnss_sensors_)
+            gnss_cursors_.push_back(gnss_sensor->getSampleHead());
+        // A cycle reads at most the buffered samples of each sensor: sized once, never grown
+        std::size_t buffered = 0;
+        for (const auto& imu_sensor : imu_sensors_)
+            buffered += imu_sensor->getBufferCapacity();
+        for (const auto& gnss_sensor : gnss_sensors_)
+            buffered += gnss_sensor->getBufferCapacity();
+        navigation_samples_.reserve(buffered);
+        predictions_ = 0;
+        updates_ = 0;
+        prediction_ns_ = 0.0;
+        update_ns_ = 0.0;
+    }
+
+    // Run on the executor if one is set, otherwise on a dedicated thread
+    if (imu_quorum_ > 0)
+    {
+        fusions_ = 0;
+        latency_sum_ns_ = 0.0;
+        latency_max_ns_ = 0.0;
+        thread_ = std::thread(&ProcessingUnit::runDataDriven, this);
+    }
+    else if (executor_)
+        task_id_ = executor_->add({"ProcessingUnit", [this] { return frequency_; }, [this] { timing_.record(frequency_); tick(); }});
+    else
+        thread_ = std::thread(&ProcessingUnit::run, this);
 }
 
 // Stops the simulation thread
@@ -47,41 +100,62 @@ void ProcessingUnit::stop()
     Logger::log(Logger::Level::Info, "[ProcessingUnit] Stop");
     running_ = false;
 
+    // Wake the data-driven loop
+    if (data_signal_)
+        data_signal_->notify();
+
+    // Unschedule from the executor
+    if (executor_ && task_id_ != 0)
+    {
+        executor_->remove(task_id_);
+        task_id_ = 0;
+    }
+
     // Wait for thread to finish
     if (thread_.joinable())
         thread_.join();
+
+    // Report the measured rate and jitter (or the fusion latency)
+    if (imu_quorum_ > 0)
+    {
+        Logger::log(Logger::Level::Info, "[ProcessingUnit] Data-driven fusions: " + std::to_string(fusions_) +
+            ", mean latency " + std::to_string(fusions_ > 0 ? latency_sum_ns_ / fusions_ / 1e3 : 0.0) +
+            " us, max latency " + std::to_string(latency_max_ns_ / 1e3) + " us");
+    }
+    else
+        Logger::log(Logger::Level::Info, "[ProcessingUnit] Timing: " + timing_.summary());
+    if (fusion_engine_ == FusionEngine::Kalman)
+    {
+        Logger::log(Logger::Level::Info, "[ProcessingUnit] Kalman filter: " + std::to_string(predictions_) +
+            " predict steps (mean " + std::to_string(predictions_ > 0 ? prediction_ns_ / predictions_ : 0.0) + " ns), " +
+            std::to_string(updates_) + " update steps (mean " + std::to_string(updates_ > 0 ? update_ns_ / updates_ : 0.0) + " ns)");
+    }
+
+    // Write the pending outputs
+    recorder_->stop();
 }
 
-// Retrieve sensors data
-ProcessingOutput ProcessingUnit::getSensorData() 
+// Fuse on new IMU samples instead of polling (set before start(), 0 = periodic)
+void ProcessingUnit::setDataDriven(std::size_t imu_quorum)
 {
-    std::vector<std::array<std::optional<double>, 3>> imu_data = {};
-    std::vector<std::optional<Sensor::Timestamp>> imu_timestamps = {};
+    imu_quorum_ = std::min(imu_quorum, imu_sensors_.size());
+    if (imu_quorum_ == 0)
+        return;
+
+    // The IMUs wake the processing loop on every published sample
+    data_signal_ = std::make_shared<DataSignal>();
     for (auto& imu_sensor : imu_sensors_)
-    {
-        // Get IMU data
-        std::deque<ImuData> imu_buffer = imu_sensor->getBuffer();
-        if (!imu_buffer.empty())
-        {
-            // Get last IMU data
-            std::array<std::optional<double>, 3> last_imu = 
-            {
-                imu_buffer.back().att_rate_x, 
-                imu_buffer.back().att_rate_y, 
-                imu_buffer.back().att_rate_z
-            };
-            auto& imu_timestamp_last = imu_buffer.back().timestamp;
-            
-            // Push IMU timestamps
-            imu_timestamps.push_back({imu_timestamp_last}); //, imu_timestamp_second_last});
-            
-            // Push IMU data
-            imu_data.push_back({last_imu}); //, second_last_imu});
-        }
-    }
+        imu_sensor->setDataSignal(data_signal_);
+}
 
-    // Process IMU data
-    std::array<std::optional<double>, 3> attitude_rate = getAttitudeRate(imu_data, imu_timestamps);
+// Retrieve sensors data
+ProcessingOutput ProcessingUnit::getSensorData() 
+{
+    // Fuse the IMUs at a common timestamp (interpolated over their recent history)
+    std::optional<ImuFusion::Result> fused_imu = imu_fusion_.fuse();
+    std::array<std::optional<double>, 3> attitude_rate = {std::nullopt, std::nullopt, std::nullopt};
+    if (fused_imu)
+        attitude_rate = {fused_imu->values[0], fused_imu->values[1], fused_imu->values[2]};
 
     // Verify IMU validity
     bool valid_imu = true;
@@ -94,24 +168,31 @@ ProcessingOutput ProcessingUnit::getSensorData()
     // Get GNSS data
     std::array<std::optional<double>, 3> gnss_data = {std::nullopt, std::nullopt, std::nullopt};
     std::optional<Sensor::Timestamp> gnss_timestamp = std::nullopt;
+    std::uint64_t gnss_sequence = 0;
     for (auto& gnss_sensor : gnss_sensors_)
     {
-        std::deque<GnssData> gnss_buffer = gnss_sensor->getBuffer();
-        if (!gnss_buffer.empty())
+        std::optional<Sensor::Sample> last_sample = gnss_sensor->getLatest();
+        if (last_sample)
         {
             // If the current GNSS has more recent data, update
-            std::optional<Sensor::Timestamp> gnss_timestamp_new = gnss_buffer.back().timestamp;
-            if (gnss_timestamp_new != std::nullopt)
+            std::optional<Sensor::Timestamp> gnss_timestamp_new = last_sample->timestamp;
+            if (gnss_timestamp_new > gnss_timestamp)
             {
-                if (gnss_timestamp_new > gnss_timestamp)
-                {
-                    gnss_data = {gnss_buffer.back().pos_x, gnss_buffer.back().pos_y, gnss_buffer.back().pos_z};
-                    gnss_timestamp = gnss_buffer.back().timestamp;
-                }
-            }      
+                gnss_data = {last_sample->values[0], last_sample->values[1], last_sample->values[2]};
+                gnss_timestamp = last_sample->timestamp;
+                gnss_sequence = last_sample->sequence;
+            }
         }
     }    
 
+    // Kalman engine: the output position is the filtered one
+    if (fusion_engine_ == FusionEngine::Kalman)
+    {
+        runNavigation();
+        if (navigation_.isInitialized() && gnss_timestamp)
+            gnss_data = {navigation_.position()[0], navigation_.position()[1], navigation_.position()[2]};
+    }
+
     // Verify GNSS validity
     bool valid_gnss = true;
     if (gnss_data[0] == std::nullopt || gnss_data[1] == std::nullopt || gnss_data[2] == std::nullopt)
@@ -141,111 +222,164 @@ ProcessingOutput ProcessingUnit::getSensorData()
         gnss_data[1].value_or(0.0),
         gnss_data[2].value_or(0.0),
         valid_imu,
-        valid_gnss
+        valid_gnss,
+        fused_imu ? fused_imu->timestamp : Sensor::Timestamp(),
+        gnss_timestamp.value_or(Sensor::Timestamp()),
+        gnss_sequence
     };
 }
 
-// Retrieve attitude rate from IMU data
-std::array<std::optional<double>, 3> ProcessingUnit::getAttitudeRate(
-            std::vector<std::array<std::optional<double>, 3>> imu_data, 
-            std::vector<std::optional<Sensor::Timestamp>> imu_timestamps)
+void ProcessingUnit::run()
+{
+    // Absolute deadlines: the work time does not shift the next period
+    PeriodicTimer timer(&timing_);
+    timer.start(frequency_);
+    while(running_)
+    {
+        tick();
+        timer.wait(frequency_);
+    }
+}
+
+// Data-driven processing loop: wait for the IMU quorum (or the nominal period) and fuse
+void ProcessingUnit::runDataDriven()
 {
-    // Compute the sum of all IMU data
-    std::vector<std::optional<double>> imu_timestamp_diff = {}; 
-    std::array<std::optional<double>, 3> sum_imu_last = {std::nullopt, std::nullopt, std::nullopt};
-    std::array<std::optional<double>, 3> sum_imu_second_last = {std::nullopt, std::nullopt, std::nullopt};
-    int valid_timestamp_count = 0;
-    int valid_imu_count = 0;
-
-    for (size_t i = 0; i < imu_data.size(); i++)
+    using namespace std::chrono;
+    const auto period = duration_cast<steady_clock::duration>(duration<double>(1.0 / frequency_));
+    std::vector<std::uint64_t> fused(imu_sensors_.size(), 0);   // Samples published at the last fusion
+    auto last_fusion = steady_clock::now();
+
+    while (running_)
     {
-        auto imu = imu_data[i];
+        // Sleep until a sensor publishes or the nominal period expires
+        const auto remaining = last_fusion + period - steady_clock::now();
+        if (remaining > steady_clock::duration::zero())
+            data_signal_->waitFor(remaining);
+        if (!running_)
+            break;
 
-        // Assumption: the IMU values are valid only if all values are provided (otherwise the sensor is not correctly working)
-        if (imu[0] != std::nullopt && imu[1] != std::nullopt && imu[2] != std::nullopt)
+        // Count the IMUs with a sample newer than the last fusion
+        std::size_t fresh = 0;
+        std::optional<Sensor::Timestamp> newest;
+        for (std::size_t i = 0; i < imu_sensors_.size(); i++)
         {
-            valid_imu_count++;
-
-            // Initialize the avg value for the last IMU data if not already done
-            if (sum_imu_last[0] == std::nullopt)
+            std::optional<Sensor::Sample> sample = imu_sensors_[i]->getLatest();
+            if (sample && sample->sequence + 1 != fused[i])
             {
-                sum_imu_last[0] = 0.0;
-                sum_imu_last[1] = 0.0;
-                sum_imu_last[2] = 0.0;
-            }
-            else
-            {
-                sum_imu_last[0].value() += imu[0].value();
-                sum_imu_last[1].value() += imu[1].value();
-                sum_imu_last[2].value() += imu[2].value();
+                fresh++;
+                if (!newest || sample->timestamp > *newest)
+                    newest = sample->timestamp;
             }
         }
-    }
 
-    // Sum the timestamps values
-    double sum_timestamp = 0.0;
-    for (auto timestamp : imu_timestamps)
-    {
-        if (timestamp != std::nullopt)
+        // Fuse on quorum; the nominal period is the minimum rate (e.g. when IMUs are faulty)
+        const auto now = steady_clock::now();
+        if (fresh < imu_quorum_ && now < last_fusion + period)
+            continue;
+
+        for (std::size_t i = 0; i < imu_sensors_.size(); i++)
         {
-            valid_timestamp_count++;
-            sum_timestamp += std::chrono::duration_cast<std::chrono::milliseconds>(timestamp.value().time_since_epoch()).count();
+            std::optional<Sensor::Sample> sample = imu_sensors_[i]->getLatest();
+            if (sample)
+                fused[i] = sample->sequence + 1;
         }
-    }
+        last_fusion = now;
+        tick();
 
-    // Compute the timestamp average
-    std::optional<double> imu_time_avg = std::nullopt;
-    if (sum_timestamp != 0.0)
-    {
-        imu_time_avg = sum_timestamp / valid_timestamp_count;
-    }
-
-    // Compute the average of the IMU data
-    std::array<std::optional<double>, 3> avg_imu = {std::nullopt, std::nullopt, std::nullopt};
-    if (sum_imu_last[0] != std::nullopt)
-    {
-        avg_imu[0] = sum_imu_last[0].value() / valid_imu_count;
-        avg_imu[1] = sum_imu_last[1].value() / valid_imu_count;
-        avg_imu[2] = sum_imu_last[2].value() / valid_imu_count;
+        // Latency from the newest sample to the end of the fusion
+        if (fresh >= imu_quorum_ && newest)
+        {
+            const double latency = static_cast<double>(duration_cast<nanoseconds>(steady_clock::now() - *newest).count());
+            fusions_++;
+            latency_sum_ns_ += latency;
+            latency_max_ns_ = std::max(latency_max_ns_, latency);
+        }
     }
-
-    return avg_imu;
 }
 
-void ProcessingUnit::run()
+// Feed the IMU and GNSS samples published since the last cycle to the navigation filter, in time order
+void ProcessingUnit::runNavigation()
 {
-    while(running_)
+    using namespace std::chrono;
+
+    // Copy the new samples in place from the ring buffers (overwritten ones are skipped)
+    navigation_samples_.clear();
+    auto collect = [this](const Sensor& sensor, std::uint64_t& cursor, bool gnss) {
+        cursor = std::max(cursor, sensor.getSampleTail());
+        for (const std::uint64_t head = sensor.getSampleHead(); cursor < head; cursor++)
+        {
+            NavigationSample pending{{}, sensor.getNoise(), gnss};
+            if (sensor.readSample(cursor, pending.sample))
+                navigation_samples_.push_back(pending);
+        }
+    };
+    for (std::size_t i = 0; i < imu_sensors_.size(); i++)
+        collect(*imu_sensors_[i], imu_cursors_[i], false);
+    for (std::size_t i = 0; i < gnss_sensors_.size(); i++)
+        collect(*gnss_sensors_[i], gnss_cursors_[i], true);
+    std::sort(navigation_samples_.begin(), navigation_samples_.end(),
+        [](const NavigationSample& a, const NavigationSample& b) { return a.sample.timestamp < b.sample.timestamp; });
+
+    // Predict on every IMU sample, propagate to every GNSS sample and update
+    for (const NavigationSample& pending : navigation_samples_)
     {
+        const Sensor::Timestamp timestamp = pending.sample.timestamp;
+        if (!pending.gnss)
         {
-            // Get Sensors data
-            std::lock_guard<std::mutex> lock(output_mutex_);
-            ProcessingOutput output = getSensorData();
-
-            // Save the data in csv files
-            auto timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
-                output.timestamp.time_since_epoch()).count();
-
-            // Write IMU data
-            imu_file_ << timestamp << ","
-                    << output.attitude_rate_x << ","
-                    << output.attitude_rate_y << ","
-                    << output.attitude_rate_z << ","
-                    << output.valid_imu << "\n";
-            imu_file_.flush();
-
-            // Write GNSS data
-            gnss_file_ << timestamp << ","
-                    << output.last_pos_x << ","
-                    << output.last_pos_y << ","
-                    << output.last_pos_z << ","
-                    << output.valid_gnss << "\n";
-            gnss_file_.flush();
-
-            // Update last output
-            last_output_ = output;
+            navigation_rate_ = pending.sample.values;
+            navigation_rate_noise_ = pending.noise;
+        }
+        if (!navigation_.isInitialized())
+        {
+            // The first position initializes the filter
+            if (pending.gnss)
+            {
+                navigation_.initialize(pending.sample.values, pending.noise);
+                navigation_time_ = timestamp;
+            }
+            continue;
         }
 
-        int sleep_time_ms = static_cast<int>(1000 / frequency_);
-        std::this_thread::sleep_for(std::chrono::milliseconds(sleep_time_ms));
+        // Samples published late by the previous cycle apply at the filter time
+        const auto start = steady_clock::now();
+        if (timestamp > *navigation_time_)
+        {
+            navigation_.predict(navigation_rate_, duration<double>(timestamp - *navigation_time_).count(), navigation_rate_noise_);
+            navigation_time_ = timestamp;
+        }
+        if (pending.gnss)
+        {
+            navigation_.update(pending.sample.values, pending.noise);
+            update_ns_ += static_cast<double>(duration_cast<nanoseconds>(steady_clock::now() - start).count());
+            updates_++;
+        }
+        else
+        {
+            prediction_ns_ += static_cast<double>(duration_cast<nanoseconds>(steady_clock::now() - start).count());
+            predictions_++;
+        }
     }
-}
\ No newline at end of file
+}
+
+// One iteration of the processing loop
+void ProcessingUnit::tick()
+{
+    // Get Sensors data
+    const auto start = std::chrono::steady_clock::now();
+    MeteredLock lock(output_mutex_, metrics_);
+    ProcessingOutput output = getSensorData();
+
+    // Age of the source samples when the output is produced
+    if (output.valid_imu)
+        imu_latency_.record(std::chrono::duration_cast<std::chrono::nanoseconds>(output.timestamp - output.imu_sample_time).count());
+    if (output.valid_gnss)
+        gnss_latency_.record(std::chrono::duration_cast<std::chrono::nanoseconds>(output.timestamp - output.gnss_sample_time).count());
+
+    // Hand the output over to the recorder thread (no formatting or I/O here)
+    recorder_->push(output);
+
+    // Publish the output to the bus subscribers
+    output_topic_->publish(output);
+    metrics_.addProduced();
+    metrics_.recordTick(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+}
@@ -0,0 +1,230 @@
+#include "BinaryRecorder.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace recording
+{
+    // Byte offset of a column inside a chunk
+    std::size_t columnOffset(std::uint32_t chunk_rows, std::size_t column)
+    {
+        // Timestamp and values are 8 bytes wide, the validity column comes last
+        const std::size_t offset = sizeof(ChunkHeader);
+        if (column <= value_columns)
+            return offset + column * 8 * chunk_rows;
+        return offset + (value_columns + 1) * 8 * chunk_rows;
+    }
+
+    // Total size of a chunk for a given number of rows
+    std::size_t chunkSize(std::uint32_t chunk_rows)
+    {
+        const std::size_t used = columnOffset(chunk_rows, column_total - 1) + chunk_rows;
+        return (used + page_size - 1) / page_size * page_size;
+    }
+
+    // Copy a name into a fixed-size field
+    static void copyName(char* destination, const std::string& name)
+    {
+        std::memset(destination, 0, name_length);
+        std::memcpy(destination, name.data(), std::min(name.size(), name_length - 1));
+    }
+
+    // Nanoseconds since the clock epoch
+    template <typename TimePoint>
+    static std::int64_t toNanoseconds(TimePoint time_point)
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(time_point.time_since_epoch()).count();
+    }
+}
+
+// Constructor: create the file and write the header
+BinaryRecorder::BinaryRecorder(
+    const std::string& path,
+    const std::string& stream_name,
+    const std::array<std::string, recording::value_columns>& value_names,
+    const std::vector<std::string>& sensor_names,
+    Sensor::Timestamp origin,
+    std::uint32_t chunk_rows
+) : file_(path, std::ios::out | std::ios::binary | std::ios::trunc), chunk_rows_(chunk_rows > 0 ? chunk_rows : 1)
+{
+    chunk_.assign(recording::chunkSize(chunk_rows_), 0);
+
+    // Match the steady clock origin with the wall clock
+    auto system_now = std::chrono::system_clock::now();
+    auto steady_now = std::chrono::steady_clock::now();
+    auto system_origin = system_now - std::chrono::duration_cast<std::chrono::system_clock::duration>(steady_now - origin);
+
+    std::vector<char> page(recording::page_size, 0);
+    auto* header = reinterpret_cast<recording::FileHeader*>(page.data());
+    std::memcpy(header->magic, recording::file_magic, sizeof(header->magic));
+    header->version = recording::format_version;
+    header->header_size = recording::page_size;
+    header->chunk_rows = chunk_rows_;
+    header->chunk_size = static_cast<std::uint32_t>(chunk_.size());
+    header->origin_steady_ns = recording::toNanoseconds(origin);
+    header->origin_system_ns = recording::toNanoseconds(system_origin);
+    recording::copyName(header->stream_name, stream_name);
+
+    // Schema
+    header->column_count = recording::column_total;
+    recording::copyName(header->columns[0].name, "timestamp");
+    header->columns[0].type = recording::ColumnType::Int64;
+    header->columns[0].width = 8;
+    for (std::size_t i = 0; i < recording::value_columns; i++)
+    {
+        recording::copyName(header->columns[i + 1].name, value_names[i]);
+        header->columns[i + 1].type = recording::ColumnType::Float64;
+        header->columns[i + 1].width = 8;
+    }
+    recording::copyName(header->columns[recording::column_total - 1].name, "valid");
+    header->columns[recording::column_total - 1].type = recording::ColumnType::UInt8;
+    header->columns[recording::column_total - 1].width = 1;
+
+    // Sensor names
+    header->sensor_count = static_cast<std::uint32_t>(std::min(sensor_names.size(), recording::max_sensors));
+    for (std::size_t i = 0; i < header->sensor_count; i++)
+        recording::copyName(header->sensor_names[i], sensor_names[i]);
+
+    file_.write(page.data(), page.size());
+}
+
+// Destructor: write the pending rows
+BinaryRecorder::~BinaryRecorder()
+{
+    if (rows_ > 0)
+        flush();
+}
+
+// Append a row
+void BinaryRecorder::append(Sensor::Timestamp timestamp, double value_0, double value_1, double value_2, bool valid)
+{
+    const std::int64_t timestamp_ns = recording::toNanoseconds(timestamp);
+    char* data = chunk_.data();
+
+    std::memcpy(data + recording::columnOffset(chunk_rows_, 0) + rows_ * 8, &timestamp_ns, 8);
+    std::memcpy(data + recording::columnOffset(chunk_rows_, 1) + rows_ * 8, &value_0, 8);
+    std::memcpy(data + recording::columnOffset(chunk_rows_, 2) + rows_ * 8, &value_1, 8);
+    std::memcpy(data + recording::columnOffset(chunk_rows_, 3) + rows_ * 8, &value_2, 8);
+    data[recording::columnOffset(chunk_rows_, 4) + rows_] = valid ? 1 : 0;
+
+    // Keep the chunk time range up to date
+    auto* header = reinterpret_cast<recording::ChunkHeader*>(data);
+    if (rows_ == 0)
+        header->first_timestamp_ns = timestamp_ns;
+    header->last_timestamp_ns = timestamp_ns;
+
+    rows_++;
+    if (rows_ == chunk_rows_)
+    {
+        // Chunk complete: write it and start the next one
+        writeChunk();
+        std::fill(chunk_.begin(), chunk_.end(), 0);
+        rows_ = 0;
+        chunk_index_++;
+    }
+}
+
+// Write the current (partial) chunk and flush the file
+void BinaryRecorder::flush()
+{
+    if (rows_ > 0)
+        writeChunk();
+    file_.flush();
+}
+
+// Write the current chunk at its position in the file
+void BinaryRecorder::writeChunk()
+{
+    auto* header = reinterpret_cast<recording::ChunkHeader*>(chunk_.data());
+    std::memcpy(header->magic, recording::chunk_magic, sizeof(header->magic));
+    header->row_count = rows_;
+    header->chunk_index = chunk_index_;
+
+    // A partial chunk is rewritten in place until it is complete
+    file_.seekp(static_cast<std::streamoff>(recording::page_size + chunk_index_ * chunk_.size()));
+    file_.write(chunk_.data(), static_cast<std::streamsize>(chunk_.size()));
+}
+
+// Constructor: map the file (check isOpen() for errors)
+RecordingReader::RecordingReader(const std::string& path)
+{
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return;
+
+    struct stat info;
+    if (::fstat(fd, &info) == 0 && static_cast<std::size_t>(info.st_size) >= recording::page_size)
+    {
+        void* mapping = ::mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping != MAP_FAILED)
+        {
+            data_ = static_cast<const char*>(mapping);
+            size_ = info.st_size;
+        }
+    }
+    ::close(fd);
+
+    if (data_ == nullptr)
+        return;
+
+    // Validate the header (a truncated or foreign file must not place the chunks or the schema
+    // outside the mapping and the header arrays)
+    auto* header = reinterpret_cast<const recording::FileHeader*>(data_);
+    if (std::memcmp(header->magic, recording::file_magic, sizeof(header->magic)) != 0 ||
+        header->version != recording::format_version ||
+        header->chunk_size == 0 || header->chunk_size != recording::chunkSize(header->chunk_rows) ||
+        header->header_size < sizeof(recording::FileHeader) || header->header_size > size_ ||
+        header->column_count != recording::column_total || header->sensor_count > recording::max_sensors)
+        return;
+
+    // Only the chunks fully mapped are readable
+    header_ = header;
+    chunk_count_ = (size_ - header_->header_size) / header_->chunk_size;
+}
+
+// Destructor: unmap the file
+RecordingReader::~RecordingReader()
+{
+    if (data_ != nullptr)
+        ::munmap(const_cast<char*>(data_), size_);
+}
+
+// Get a chunk header
+const recording::ChunkHeader& RecordingReader::chunk(std::size_t index) const
+{
+    return *reinterpret_cast<const recording::ChunkHeader*>(chunkData(index));
+}
+
+// Get the number of valid rows of a chunk (at most chunk_rows, whatever the chunk header says)
+std::uint32_t RecordingReader::rowCount(std::size_t index) const
+{
+    return std::min(chunk(index).row_count, header_->chunk_rows);
+}
+
+// Get the timestamp column of a chunk
+const std::int64_t* RecordingReader::timestamps(std::size_t index) const
+{
+    return reinterpret_cast<const std::int64_t*>(chunkData(index) + recording::columnOffset(header_->chunk_rows, 0));
+}
+
+// Get a value column of a chunk
+const double* RecordingReader::values(std::size_t index, std::size_t column) const
+{
+    return reinterpret_cast<const double*>(chunkData(index) + recording::columnOffset(header_->chunk_rows, column + 1));
+}
+
+// Get the validity column of a chunk
+const std::uint8_t* RecordingReader::valid(std::size_t index) const
+{
+    return reinterpret_cast<const std::uint8_t*>(chunkData(index) + recording::columnOffset(header_->chunk_rows, recording::column_total - 1));
+}
+
+// Get the start of a chunk
+const char* RecordingReader::chunkData(std::size_t index) const
+{
+    return data_ + header_->header_size + index * header_->chunk_size;
+}
@@ -0,0 +1,153 @@
+#include "CsvWriter.hpp"
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <csignal>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace
+{
+    // Maximum size of a formatted row
+    constexpr std::size_t max_row_size = 256;
+
+    // Writers flushed from signal handlers
+    constexpr std::size_t max_writers = 16;
+    std::array<std::atomic<CsvWriter*>, max_writers> signal_writers{};
+
+    // Write a whole buffer, retrying on partial writes (async-signal-safe)
+    void writeAll(int fd, const char* data, std::size_t size)
+    {
+        while (size > 0)
+        {
+            ssize_t written = ::write(fd, data, size);
+            if (written <= 0)
+                return;
+            data += written;
+            size -= static_cast<std::size_t>(written);
+        }
+    }
+}
+
+// Constructor: open the file and write the header line
+CsvWriter::CsvWriter(const std::string& path, const std::string& header, char* buffer, std::size_t capacity,
+                     const FlushPolicy& policy, int precision)
+    : buffer_(buffer), capacity_(capacity), policy_(policy), precision_(precision)
+{
+    fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd_ < 0 || capacity_ < max_row_size)
+        return;
+
+    writeAll(fd_, header.data(), header.size());
+    writeAll(fd_, "\n", 1);
+
+    if (policy_.on_signal)
+        registerWriter();
+}
+
+// Destructor: flush and close the file
+CsvWriter::~CsvWriter()
+{
+    unregisterWriter();
+    if (fd_ >= 0)
+    {
+        flush();
+        ::close(fd_);
+    }
+}
+
+// Append a row: timestamp, three values and a validity flag
+void CsvWriter::writeRow(std::int64_t timestamp, double value_0, double value_1, double value_2, bool valid)
+{
+    if (fd_ < 0 || capacity_ < max_row_size)
+        return;
+
+    // Make room for a full row
+    if (capacity_ - used_ < max_row_size)
+        flush();
+
+    if (pending_rows_ == 0)
+        first_pending_ = std::chrono::steady_clock::now();
+
+    char* end = buffer_ + capacity_;
+    used_ = std::to_chars(buffer_ + used_, end, timestamp).ptr - buffer_;
+    buffer_[used_++] = ',';
+    appendDouble(value_0);
+    buffer_[used_++] = ',';
+    appendDouble(value_1);
+    buffer_[used_++] = ',';
+    appendDouble(value_2);
+    buffer_[used_++] = ',';
+    buffer_[used_++] = valid ? '1' : '0';
+    buffer_[used_++] = '\n';
+    pending_rows_++;
+
+    if (policy_.every_rows > 0 && pending_rows_ >= policy_.every_rows)
+        flush();
+}
+
+// Apply the time-based flush policy
+void CsvWriter::poll(std::chrono::steady_clock::time_point now)
+{
+    if (pending_rows_ > 0 && policy_.every_interval.count() > 0 && now - first_pending_ >= policy_.every_interval)
+        flush();
+}
+
+// Write the buffer to the file
+void CsvWriter::flush()
+{
+    if (fd_ >= 0 && used_ > 0)
+        writeAll(fd_, buffer_, used_);
+    used_ = 0;
+    pending_rows_ = 0;
+}
+
+// Append a double with the configured precision
+void CsvWriter::appendDouble(double value)
+{
+    auto result = std::to_chars(buffer_ + used_, buffer_ + capacity_, value, std::chars_format::general, precision_);
+    used_ = result.ptr - buffer_;
+}
+
+// Register the writer for signal flushing
+void CsvWriter::registerWriter()
+{
+    for (auto& slot : signal_writers)
+    {
+        CsvWriter* expected = nullptr;
+        if (slot.compare_exchange_strong(expected, this))
+            return;
+    }
+}
+
+// Unregister the writer
+void CsvWriter::unregisterWriter()
+{
+    for (auto& slot : signal_writers)
+    {
+        CsvWriter* expected = this;
+        slot.compare_exchange_strong(expected, nullptr);
+    }
+}
+
+// Flush all the open writers from signal handlers
+void CsvWriter::installSignalHandlers()
+{
+    for (int signal : {SIGINT, SIGTERM, SIGABRT, SIGSEGV})
+        std::signal(signal, &CsvWriter::onSignal);
+}
+
+// Signal handler: write out pending buffers (best effort), then run the default action
+void CsvWriter::onSignal(int signal)
+{
+    for (auto& slot : signal_writers)
+    {
+        CsvWriter* writer = slot.exchange(nullptr);
+        if (writer != nullptr && writer->fd_ >= 0 && writer->used_ > 0)
+            writeAll(writer->fd_, writer->buffer_, writer->used_);
+    }
+
+    std::signal(signal, SIG_DFL);
+    std::raise(signal);
+}
@@ -0,0 +1,155 @@
+#include "Recorder.hpp"
+#include <chrono>
+
+namespace
+{
+    // Size of each CSV output buffer
+    constexpr std::size_t csv_buffer_size = 64 * 1024;
+
+    // Writer wake-up period when no time-based flush is configured
+    constexpr std::chrono::milliseconds idle_period{100};
+}
+
+// Constructor: create the output files in the data directory
+Recorder::Recorder(
+    const std::string& data_directory,
+    RecordingFormat format,
+    const std::vector<std::string>& imu_names,
+    const std::vector<std::string>& gnss_names,
+    const FlushPolicy& flush_policy,
+    std::size_t queue_capacity
+) : format_(format), flush_policy_(flush_policy), queue_(queue_capacity)
+{
+    if (format_ == RecordingFormat::Binary)
+    {
+        // Schema, sensor names and clock origin go in the file headers
+        auto origin = std::chrono::steady_clock::now();
+        imu_binary_ = std::make_unique<BinaryRecorder>(data_directory + "/imu.bin", "imu",
+            std::array<std::string, 3>{"attitude_rate_x", "attitude_rate_y", "attitude_rate_z"}, imu_names, origin);
+        gnss_binary_ = std::make_unique<BinaryRecorder>(data_directory + "/gnss.bin", "gnss",
+            std::array<std::string, 3>{"pos_x", "pos_y", "pos_z"}, gnss_names, origin);
+        return;
+    }
+
+    imu_buffer_.resize(csv_buffer_size);
+    gnss_buffer_.resize(csv_buffer_size);
+    imu_csv_ = std::make_unique<CsvWriter>(data_directory + "/imu.csv",
+        "timestamp,attitude_rate_x,attitude_rate_y,attitude_rate_z,valid",
+        imu_buffer_.data(), imu_buffer_.size(), flush_policy_);
+    gnss_csv_ = std::make_unique<CsvWriter>(data_directory + "/gnss.csv",
+        "timestamp,pos_x,pos_y,pos_z,valid",
+        gnss_buffer_.data(), gnss_buffer_.size(), flush_policy_);
+}
+
+// Destructor: stop the writer thread
+Recorder::~Recorder()
+{
+    stop();
+}
+
+// Start the writer thread
+void Recorder::start()
+{
+    if (running_.exchange(true))
+        return;
+    thread_ = std::thread(&Recorder::run, this);
+}
+
+// Stop the writer thread, writing every queued output
+void Recorder::stop()
+{
+    if (running_.exchange(false))
+    {
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex_);
+        }
+        wake_.notify_one();
+    }
+
+    // Wait for thread to finish
+    if (thread_.joinable())
+        thread_.join();
+}
+
+// Enqueue an output (fusion thread)
+bool Recorder::push(const ProcessingOutput& output)
+{
+    ProcessingOutput copy = output;
+    if (!queue_.tryPush(std::move(copy)))
+    {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    // Wake the writer only when a row-count flush is due soon; otherwise let it batch
+    if (idle_.load(std::memory_order_relaxed) && flush_policy_.every_rows > 0)
+        wake_.notify_one();
+    return true;
+}
+
+// Writer thread loop
+void Recorder::run()
+{
+    const auto period = flush_policy_.every_interval.count() > 0 ? flush_policy_.every_interval : idle_period;
+    ProcessingOutput output;
+
+    while (true)
+    {
+        const bool stopping = !running_;
+
+        // Write everything queued so far
+        while (queue_.tryPop(output))
+            write(output);
+
+        // Time-based flush policy
+        auto now = std::chrono::steady_clock::now();
+        if (imu_csv_)
+        {
+            imu_csv_->poll(now);
+            gnss_csv_->poll(now);
+        }
+
+        if (stopping)
+            break;
+
+        // Sleep until woken up or the next flush check
+        std::unique_lock<std::mutex> lock(wake_mutex_);
+        if (!running_)
+            continue;
+        idle_ = true;
+        wake_.wait_for(lock, period);
+        idle_ = false;
+    }
+
+    // Stop: write out everything
+    flush();
+}
+
+// Write one output to the sinks
+void Recorder::write(const ProcessingOutput& output)
+{
+    if (format_ == RecordingFormat::Binary)
+    {
+        imu_binary_->append(output.timestamp, output.attitude_rate_x, output.attitude_rate_y, output.attitude_rate_z, output.valid_imu);
+        gnss_binary_->append(output.timestamp, output.last_pos_x, output.last_pos_y, output.last_pos_z, output.valid_gnss);
+        return;
+    }
+
+    auto timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(output.timestamp.time_since_epoch()).count();
+    imu_csv_->writeRow(timestamp, output.attitude_rate_x, output.attitude_rate_y, output.attitude_rate_z, output.valid_imu);
+    gnss_csv_->writeRow(timestamp, output.last_pos_x, output.last_pos_y, output.last_pos_z, output.valid_gnss);
+}
+
+// Flush the sinks
+void Recorder::flush()
+{
+    if (format_ == RecordingFormat::Binary)
+    {
+        imu_binary_->flush();
+        gnss_binary_->flush();
+        return;
+    }
+
+    imu_csv_->flush();
+    gnss_csv_->flush();
+}
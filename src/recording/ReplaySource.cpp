@@ -0,0 +1,187 @@
+#include "ReplaySource.hpp"
+#include "BinaryRecorder.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+    // Consumed CSV bytes released from the mapping at once
+    constexpr std::size_t release_block = 4 * 1024 * 1024;
+
+    // True if the path ends with the given suffix
+    bool endsWith(const std::string& text, const std::string& suffix)
+    {
+        return text.size() >= suffix.size() && text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+    }
+}
+
+// Constructor: map the recording
+ReplaySource::ReplaySource(const std::string& path) : path_(path)
+{
+    // Binary recordings are mapped by their reader
+    if (endsWith(path, ".bin"))
+    {
+        binary_ = std::make_unique<RecordingReader>(path);
+        if (!binary_->isOpen())
+            binary_.reset();
+        return;
+    }
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return;
+
+    struct stat info;
+    if (::fstat(fd, &info) == 0 && info.st_size > 0)
+    {
+        void* mapping = ::mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping != MAP_FAILED)
+        {
+            csv_data_ = static_cast<const char*>(mapping);
+            csv_size_ = info.st_size;
+            ::madvise(mapping, csv_size_, MADV_SEQUENTIAL);
+        }
+    }
+    ::close(fd);
+
+    // Skip the header line
+    if (csv_data_ != nullptr && (csv_data_[0] < '0' || csv_data_[0] > '9'))
+    {
+        const char* end = static_cast<const char*>(std::memchr(csv_data_, '\n', csv_size_));
+        first_row_ = end ? static_cast<std::size_t>(end - csv_data_) + 1 : csv_size_;
+    }
+    cursor_.offset = first_row_;
+}
+
+// Destructor: unmap the file
+ReplaySource::~ReplaySource()
+{
+    if (csv_data_ != nullptr)
+        ::munmap(const_cast<char*>(csv_data_), csv_size_);
+}
+
+// Read the next record
+bool ReplaySource::next(Record& record)
+{
+    if (!read(cursor_, record))
+        return false;
+    releaseConsumed();
+    return true;
+}
+
+// Go back to the first record
+void ReplaySource::rewind()
+{
+    cursor_ = Cursor();
+    cursor_.offset = first_row_;
+    released_ = 0;
+}
+
+// Nominal rate in Hz from the median interval of the first records
+double ReplaySource::estimateFrequency(std::size_t records) const
+{
+    Cursor cursor;
+    cursor.offset = first_row_;
+    Record record;
+    std::vector<std::int64_t> intervals;
+    std::int64_t previous = 0;
+    for (std::size_t i = 0; i < records && read(cursor, record); i++)
+    {
+        if (i > 0 && record.time_ns > previous)
+            intervals.push_back(record.time_ns - previous);
+        previous = record.time_ns;
+    }
+    if (intervals.empty())
+        return 0.0;
+
+    std::nth_element(intervals.begin(), intervals.begin() + intervals.size() / 2, intervals.end());
+    return 1e9 / static_cast<double>(intervals[intervals.size() / 2]);
+}
+
+// Read the record at a cursor and advance it
+bool ReplaySource::read(Cursor& cursor, Record& record) const
+{
+    if (binary_)
+        return readBinary(cursor, record);
+    if (csv_data_ != nullptr)
+        return readCsv(cursor, record);
+    return false;
+}
+
+// Parse the next "timestamp_ms,value_0,value_1,value_2,valid" line (malformed lines are skipped)
+bool ReplaySource::readCsv(Cursor& cursor, Record& record) const
+{
+    const char* const end = csv_data_ + csv_size_;
+    while (cursor.offset < csv_size_)
+    {
+        const char* line = csv_data_ + cursor.offset;
+        const char* line_end = static_cast<const char*>(std::memchr(line, '\n', end - line));
+        if (line_end == nullptr)
+            line_end = end;
+        cursor.offset = static_cast<std::size_t>(line_end - csv_data_) + 1;
+
+        std::int64_t timestamp_ms = 0;
+        auto result = std::from_chars(line, line_end, timestamp_ms);
+        bool ok = result.ec == std::errc();
+        for (double& value : record.values)
+        {
+            ok = ok && result.ptr < line_end && *result.ptr == ',';
+            if (ok)
+            {
+                result = std::from_chars(result.ptr + 1, line_end, value);
+                ok = result.ec == std::errc();
+            }
+        }
+        ok = ok && result.ptr + 1 < line_end && *result.ptr == ',';
+        if (!ok)
+            continue;
+
+        record.time_ns = timestamp_ms * 1000000;
+        record.valid = result.ptr[1] == '1';
+        return true;
+    }
+    return false;
+}
+
+// Read the next row of the binary recording
+bool ReplaySource::readBinary(Cursor& cursor, Record& record) const
+{
+    while (cursor.chunk < binary_->chunkCount())
+    {
+        if (cursor.row >= binary_->rowCount(cursor.chunk))
+        {
+            cursor.chunk++;
+            cursor.row = 0;
+            continue;
+        }
+
+        record.time_ns = binary_->timestamps(cursor.chunk)[cursor.row];
+        for (std::size_t column = 0; column < record.values.size(); column++)
+            record.values[column] = binary_->values(cursor.chunk, column)[cursor.row];
+        record.valid = binary_->valid(cursor.chunk)[cursor.row] != 0;
+        cursor.row++;
+        return true;
+    }
+    return false;
+}
+
+// Drop the consumed CSV pages from the mapping (they are read again from the file after a rewind)
+void ReplaySource::releaseConsumed()
+{
+    if (csv_data_ == nullptr || cursor_.offset < released_ + release_block)
+        return;
+
+    const std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    const std::size_t release_end = cursor_.offset / page * page;
+    if (release_end > released_)
+    {
+        ::madvise(const_cast<char*>(csv_data_) + released_, release_end - released_, MADV_DONTNEED);
+        released_ = release_end;
+    }
+}
@@ -0,0 +1,42 @@
+#include "DataSignal.hpp"
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace
+{
+    // Futex operations on the 32-bit flag (private: shared by threads of this process only)
+    long futex(std::atomic<std::uint32_t>& word, int operation, std::uint32_t value, const timespec* timeout)
+    {
+        static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t), "Futex word must be 32 bits");
+        return ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), operation, value, timeout, nullptr, 0);
+    }
+}
+
+// Signal new data (any thread, lock-free)
+void DataSignal::notify()
+{
+    // Already pending: the consumer is awake or will see the flag before sleeping
+    if (pending_.exchange(1, std::memory_order_acq_rel) == 0)
+        futex(pending_, FUTEX_WAKE_PRIVATE, 1, nullptr);
+}
+
+// Wait until notified or the timeout expires, consuming the notification (single consumer)
+bool DataSignal::waitFor(std::chrono::nanoseconds timeout)
+{
+    using namespace std::chrono;
+    const auto deadline = steady_clock::now() + timeout;
+
+    while (pending_.exchange(0, std::memory_order_acq_rel) == 0)
+    {
+        const std::int64_t remaining = duration_cast<nanoseconds>(deadline - steady_clock::now()).count();
+        if (remaining <= 0)
+            return false;
+
+        // Sleeps only if the flag is still 0 (a notify in between returns immediately)
+        timespec relative{static_cast<time_t>(remaining / 1000000000), static_cast<long>(remaining % 1000000000)};
+        futex(pending_, FUTEX_WAIT_PRIVATE, 0, &relative);
+    }
+    return true;
+}
@@ -0,0 +1,122 @@
+#include "PeriodicTimer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+#include <sys/prctl.h>
+
+namespace
+{
+    // Current steady clock time in ns
+    std::int64_t nowNs()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // Period in ns for a frequency in Hz
+    std::int64_t periodNs(double frequency)
+    {
+        return frequency > 0.0 ? static_cast<std::int64_t>(std::llround(1e9 / frequency)) : 1000000000;
+    }
+
+    // Below this period the end of the wait is spun instead of slept
+    constexpr std::int64_t spin_period_ns = 1000000;
+
+    // Longest spin before a deadline
+    constexpr std::int64_t max_spin_ns = 50000;
+}
+
+// Clear the statistics (before the component starts)
+void TimingMonitor::reset()
+{
+    last_ns_ = 0;
+    mean_ns_ = 0.0;
+    m2_ns_ = 0.0;
+    current_ = TimingStats();
+    stats_.store(current_);
+}
+
+// Record an activation now, at the given nominal frequency
+void TimingMonitor::record(double frequency)
+{
+    const std::int64_t now = nowNs();
+    const std::int64_t previous = last_ns_;
+    last_ns_ = now;
+    current_.frequency = frequency;
+    if (previous == 0)
+        return; // First activation: no period yet
+
+    const double nominal = static_cast<double>(periodNs(frequency));
+    const double period = static_cast<double>(now - previous);
+
+    // Welford update of the period mean and variance
+    current_.activations++;
+    const double delta = period - mean_ns_;
+    mean_ns_ += delta / static_cast<double>(current_.activations);
+    m2_ns_ += delta * (period - mean_ns_);
+
+    current_.mean_period_ns = mean_ns_;
+    current_.period_error_ns = mean_ns_ - nominal;
+    current_.jitter_ns = current_.activations > 1
+        ? std::sqrt(m2_ns_ / static_cast<double>(current_.activations - 1))
+        : 0.0;
+    current_.max_error_ns = std::max(current_.max_error_ns, std::abs(period - nominal));
+    if (period > 1.5 * nominal)
+        current_.overruns++;
+
+    stats_.store(current_);
+}
+
+// One-line summary for the log
+std::string TimingMonitor::summary() const
+{
+    const TimingStats stats = this->stats();
+    char text[256];
+    std::snprintf(text, sizeof(text),
+        "%.2f Hz nominal, %.2f Hz measured over %llu periods, period error %+.1f us, jitter %.1f us, max error %.1f us, overruns %llu",
+        stats.frequency,
+        stats.mean_period_ns > 0.0 ? 1e9 / stats.mean_period_ns : 0.0,
+        static_cast<unsigned long long>(stats.activations),
+        stats.period_error_ns / 1e3,
+        stats.jitter_ns / 1e3,
+        stats.max_error_ns / 1e3,
+        static_cast<unsigned long long>(stats.overruns));
+    return text;
+}
+
+// Start the timeline now and record the first activation (calling thread)
+void PeriodicTimer::start(double frequency)
+{
+    // Wake up as close to the deadlines as the kernel allows (default slack is 50 us)
+    ::prctl(PR_SET_TIMERSLACK, 1UL, 0UL, 0UL, 0UL);
+
+    deadline_ = std::chrono::steady_clock::now();
+    if (monitor_)
+        monitor_->record(frequency);
+}
+
+// Sleep until the next deadline at the given frequency and record the activation
+void PeriodicTimer::wait(double frequency)
+{
+    using namespace std::chrono;
+    const std::int64_t period = periodNs(frequency);
+
+    // Next absolute deadline; skip the periods already missed, keeping the phase
+    deadline_ += nanoseconds(period);
+    const auto now = steady_clock::now();
+    if (deadline_ <= now)
+    {
+        const std::int64_t late = duration_cast<nanoseconds>(now - deadline_).count();
+        deadline_ += nanoseconds((late / period + 1) * period);
+    }
+
+    // Sleep, then spin the last part of short periods (the wake-up latency is tens of us)
+    const std::int64_t spin = period < spin_period_ns ? std::min(period / 10, max_spin_ns) : 0;
+    std::this_thread::sleep_until(deadline_ - nanoseconds(spin));
+    while (steady_clock::now() < deadline_)
+        ;
+
+    if (monitor_)
+        monitor_->record(frequency);
+}
@@ -0,0 +1,254 @@
+#include "Reactor.hpp"
+#include "../logging/Logger.hpp"
+#include <chrono>
+#include <cstring>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+namespace
+{
+    // Current steady clock time in ns (same clock as CLOCK_MONOTONIC)
+    std::int64_t nowNs()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // Task being ticked on the current thread (a tick may stop its own component)
+    thread_local const void* current_task = nullptr;
+
+    // Period in ns for a frequency in Hz
+    std::int64_t periodNs(double frequency)
+    {
+        return frequency > 0.0 ? static_cast<std::int64_t>(1e9 / frequency) : 1000000000;
+    }
+}
+
+// Constructor: create the timer and wake-up descriptors
+Reactor::Reactor(std::shared_ptr<WorkerPool> pool) : pool_(std::move(pool))
+{
+    epoll_fd_ = ::epoll_create1(EPOLL_CLOEXEC);
+    timer_fd_ = ::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    event_fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epoll_fd_ < 0 || timer_fd_ < 0 || event_fd_ < 0)
+    {
+        Logger::log(Logger::Level::Error, "[Reactor] Cannot create descriptors: " + std::string(std::strerror(errno)));
+        return;
+    }
+
+    for (int fd : {timer_fd_, event_fd_})
+    {
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+        ::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event);
+    }
+}
+
+// Destructor: stop the reactor thread and close the descriptors
+Reactor::~Reactor()
+{
+    stop();
+    for (int fd : {epoll_fd_, timer_fd_, event_fd_})
+    {
+        if (fd >= 0)
+            ::close(fd);
+    }
+}
+
+// Start the reactor thread
+void Reactor::start()
+{
+    if (running_.exchange(true))
+        return;
+
+    Logger::log(Logger::Level::Info, "[Reactor] Start");
+    thread_ = std::thread(&Reactor::run, this);
+}
+
+// Stop the reactor thread (registered tasks are kept)
+void Reactor::stop()
+{
+    if (!running_.exchange(false))
+        return;
+
+    Logger::log(Logger::Level::Info, "[Reactor] Stop");
+    wake();
+
+    // Wait for thread to finish
+    if (thread_.joinable())
+        thread_.join();
+
+    // Wait for the ticks still running on the pool
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_.wait(lock, [this] { return in_flight_ == 0; });
+}
+
+// Schedule a task; the first tick runs immediately
+Executor::TaskId Reactor::add(PeriodicTask task)
+{
+    TaskId id;
+    std::size_t tasks;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        id = next_id_++;
+        auto entry = std::make_shared<Task>();
+        entry->id = id;
+        entry->task = std::move(task);
+        entry->deadline_ns = nowNs();
+        tasks_[id] = entry;
+        heap_.push({entry->deadline_ns, id});
+        tasks = tasks_.size();
+    }
+
+    // Every task may fall due at once: room for all their ticks, so that dispatching allocates nothing
+    if (pool_)
+        pool_->reserve(tasks);
+    wake();
+    return id;
+}
+
+// Unschedule a task; on return the task is not running and will not run again
+void Reactor::remove(TaskId id)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto it = tasks_.find(id);
+    if (it == tasks_.end())
+        return;
+
+    std::shared_ptr<Task> task = it->second;
+    task->removed = true;
+    tasks_.erase(it);
+
+    // Wait for a tick in progress (unless a tick removes its own task)
+    if (current_task != task.get())
+        idle_.wait(lock, [&] { return !task->busy; });
+}
+
+// Number of scheduled tasks
+std::size_t Reactor::size() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return tasks_.size();
+}
+
+// Reactor loop
+void Reactor::run()
+{
+    std::vector<Task*> due;
+    epoll_event events[2];
+
+    while (running_)
+    {
+        {
+            // Collect the tasks whose deadline has passed (room for all of them, grown only on add())
+            std::lock_guard<std::mutex> lock(mutex_);
+            due.reserve(tasks_.size());
+            const std::int64_t now = nowNs();
+            while (!heap_.empty() && heap_.top().deadline_ns <= now)
+            {
+                Entry entry = heap_.top();
+                heap_.pop();
+
+                auto it = tasks_.find(entry.id);
+                if (it == tasks_.end())
+                    continue; // Removed meanwhile
+
+                it->second->busy = true;
+                it->second->dispatched = it->second;
+                in_flight_++;
+                due.push_back(it->second.get());
+            }
+
+            // Nothing due: arm the timer for the earliest deadline before waiting
+            if (due.empty())
+                armTimer();
+        }
+
+        if (!due.empty())
+        {
+            // The job captures two pointers, small enough for std::function not to allocate
+            for (Task* task : due)
+            {
+                if (pool_)
+                    pool_->submit([this, task] { runTick(task); });
+                else
+                    runTick(task);
+            }
+            due.clear();
+            continue; // Check again: ticks take time
+        }
+
+        // Wait for the timer or a wake-up
+        int count = ::epoll_wait(epoll_fd_, events, 2, -1);
+        for (int i = 0; i < count; i++)
+        {
+            std::uint64_t value;
+            [[maybe_unused]] ssize_t bytes = ::read(events[i].data.fd, &value, sizeof(value));
+        }
+    }
+}
+
+// Run one tick and reschedule the task (reactor thread or pool worker)
+void Reactor::runTick(Task* task)
+{
+    // Own the task until the tick is rescheduled: a tick may remove its own task
+    const std::shared_ptr<Task> owner = std::move(task->dispatched);
+    if (!task->removed)
+    {
+        current_task = task;
+        task->task.tick();
+        current_task = nullptr;
+    }
+    reschedule(owner);
+}
+
+// Compute the next deadline and put the task back in the heap (after its tick)
+void Reactor::reschedule(const std::shared_ptr<Task>& task)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    task->busy = false;
+    in_flight_--;
+    idle_.notify_all();
+
+    if (tasks_.find(task->id) == tasks_.end())
+        return; // Removed during the tick
+
+    // Absolute deadlines: skip the periods that were missed, keep the phase
+    const std::int64_t period = periodNs(task->task.frequency());
+    const std::int64_t now = nowNs();
+    std::int64_t next = task->deadline_ns + period;
+    if (next <= now)
+        next += ((now - next) / period + 1) * period;
+
+    task->deadline_ns = next;
+    heap_.push({next, task->id});
+
+    // Ticks on the pool finish while the reactor sleeps: bring the timer forward if needed
+    if (armed_deadline_ == 0 || next < armed_deadline_)
+        armTimer();
+}
+
+// Wake the reactor thread
+void Reactor::wake()
+{
+    std::uint64_t one = 1;
+    [[maybe_unused]] ssize_t bytes = ::write(event_fd_, &one, sizeof(one));
+}
+
+// Arm the timer for the earliest deadline (lock held)
+void Reactor::armTimer()
+{
+    itimerspec spec{};
+    armed_deadline_ = heap_.empty() ? 0 : heap_.top().deadline_ns;
+    if (!heap_.empty())
+    {
+        const std::int64_t deadline = heap_.top().deadline_ns;
+        spec.it_value.tv_sec = deadline / 1000000000;
+        spec.it_value.tv_nsec = deadline % 1000000000;
+    }
+    // A zero it_value disarms the timer when there is nothing to run
+    ::timerfd_settime(timer_fd_, TFD_TIMER_ABSTIME, &spec, nullptr);
+}
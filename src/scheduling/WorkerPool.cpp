@@ -0,0 +1,164 @@
+#include "WorkerPool.hpp"
+#include <algorithm>
+
+namespace
+{
+    // Pool and index of the worker running on the current thread
+    thread_local const WorkerPool* current_pool = nullptr;
+    thread_local std::size_t current_index = 0;
+}
+
+// Constructor: start the workers (0 = one per hardware thread)
+WorkerPool::WorkerPool(std::size_t threads)
+{
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+
+    for (std::size_t i = 0; i < threads; i++)
+        workers_.push_back(std::make_unique<Worker>());
+    for (std::size_t i = 0; i < threads; i++)
+        threads_.emplace_back(&WorkerPool::run, this, i);
+}
+
+// Destructor: stop the workers (queued jobs are discarded)
+WorkerPool::~WorkerPool()
+{
+    running_ = false;
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+    }
+    wake_.notify_all();
+
+    for (auto& thread : threads_)
+    {
+        if (thread.joinable())
+            thread.join();
+    }
+}
+
+// Preallocate every worker queue for the given number of jobs queued at once
+void WorkerPool::reserve(std::size_t jobs)
+{
+    for (auto& worker : workers_)
+    {
+        std::lock_guard<std::mutex> lock(worker->mutex);
+        worker->jobs.reserve(jobs);
+    }
+}
+
+// Queue a job
+void WorkerPool::submit(std::function<void()> job)
+{
+    const std::size_t index = current_pool == this
+        ? current_index
+        : next_.fetch_add(1, std::memory_order_relaxed) % workers_.size();
+    {
+        std::lock_guard<std::mutex> lock(workers_[index]->mutex);
+        workers_[index]->jobs.pushBack(std::move(job));
+    }
+
+    // Wake a sleeping worker, if any (pending_ and sleepers_ are checked in opposite order)
+    pending_.fetch_add(1);
+    if (sleepers_.load() > 0)
+    {
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex_);
+        }
+        wake_.notify_one();
+    }
+}
+
+// Worker loop
+void WorkerPool::run(std::size_t index)
+{
+    current_pool = this;
+    current_index = index;
+    std::function<void()> job;
+
+    while (running_)
+    {
+        if (take(index, job))
+        {
+            pending_.fetch_sub(1);
+            job();
+            job = nullptr;
+            continue;
+        }
+
+        // Nothing to run or steal: sleep until a job is submitted
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        sleepers_.fetch_add(1);
+        wake_.wait(lock, [this] { return !running_ || pending_.load() > 0; });
+        sleepers_.fetch_sub(1);
+    }
+}
+
+// Take a job: own queue first (newest), then steal from the others (oldest)
+bool WorkerPool::take(std::size_t index, std::function<void()>& job)
+{
+    {
+        Worker& own = *workers_[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.jobs.empty())
+        {
+            own.jobs.popBack(job);
+            return true;
+        }
+    }
+
+    for (std::size_t offset = 1; offset < workers_.size(); offset++)
+    {
+        Worker& victim = *workers_[(index + offset) % workers_.size()];
+        std::unique_lock<std::mutex> lock(victim.mutex, std::try_to_lock);
+        if (lock.owns_lock() && !victim.jobs.empty())
+        {
+            victim.jobs.popFront(job);
+            return true;
+        }
+    }
+    return false;
+}
+
+// Add a job at the back
+void WorkerPool::JobQueue::pushBack(std::function<void()>&& job)
+{
+    if (count_ == slots_.size())
+        grow();
+    slots_[(first_ + count_) % slots_.size()] = std::move(job);
+    count_++;
+}
+
+// Take the newest job
+void WorkerPool::JobQueue::popBack(std::function<void()>& job)
+{
+    std::function<void()>& slot = slots_[(first_ + count_ - 1) % slots_.size()];
+    job = std::move(slot);
+    slot = nullptr;
+    count_--;
+}
+
+// Take the oldest job
+void WorkerPool::JobQueue::popFront(std::function<void()>& job)
+{
+    job = std::move(slots_[first_]);
+    slots_[first_] = nullptr;
+    first_ = (first_ + 1) % slots_.size();
+    count_--;
+}
+
+// Make room for capacity jobs
+void WorkerPool::JobQueue::reserve(std::size_t capacity)
+{
+    if (capacity > slots_.size())
+        resize(capacity);
+}
+
+// Move the jobs to capacity slots, keeping the job order
+void WorkerPool::JobQueue::resize(std::size_t capacity)
+{
+    std::vector<std::function<void()>> slots(capacity);
+    for (std::size_t i = 0; i < count_; i++)
+        slots[i] = std::move(slots_[(first_ + i) % slots_.size()]);
+    slots_.swap(slots);
+    first_ = 0;
+}
@@ -0,0 +1,187 @@
+#include "NoiseGenerator.hpp"
+#include <cmath>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define NOISE_GENERATOR_X86 1
+#include <immintrin.h>
+#endif
+
+namespace
+{
+    constexpr std::size_t pairs = NoiseGenerator::block_size / 2;   // Box-Muller pairs per block
+
+    // SplitMix64 step (expands a seed into the stream states)
+    std::uint64_t splitMix64(std::uint64_t& state)
+    {
+        std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    inline double fromBits(std::uint64_t bits)
+    {
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    inline std::uint64_t toBits(double value)
+    {
+        std::uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    // Uniform in [1, 2) from the top 52 bits (no integer-to-double conversion)
+    inline double uniform12(std::uint64_t bits) { return fromBits(0x3FF0000000000000ull | (bits >> 12)); }
+
+    // The four streams of NoiseGenerator, one per vector lane
+    typedef std::uint64_t Lanes __attribute__((vector_size(NoiseGenerator::lanes * sizeof(std::uint64_t))));
+
+    // Natural log of u in (0, 1]: u = m 2^e with m in [sqrt(1/2), sqrt(2)), log m = 2 atanh((m - 1) / (m + 1)).
+    // Series truncation error below 1e-12.
+    inline double logUnit(double u)
+    {
+        // Integer operations only (a select would stop the vectorizer): high = 1 if m >= sqrt(2), then m /= 2, e += 1
+        const std::uint64_t bits = toBits(u);
+        const std::uint64_t fraction = bits & 0x000FFFFFFFFFFFFFull;
+        const std::uint64_t high = (0x6A09E667F3BCCull - fraction) >> 63;
+        const double exponent = fromBits(0x4330000000000000ull | ((bits >> 52) + high)) - 4503599627370496.0 - 1023.0;  // 2^52 trick
+        const double mantissa = fromBits(fraction | ((0x3FFull - high) << 52));
+
+        const double s = (mantissa - 1.0) / (mantissa + 1.0);
+        const double s2 = s * s;
+        const double series = s * (2.0 + s2 * (2.0 / 3.0 + s2 * (2.0 / 5.0 + s2 * (2.0 / 7.0
+            + s2 * (2.0 / 9.0 + s2 * (2.0 / 11.0 + s2 * (2.0 / 13.0)))))));
+        return exponent * 0.6931471805599453 + series;
+    }
+
+    // Square roots of non-negative values in place, with the vector instruction of the kernel
+    // (std::sqrt keeps a branch setting errno on negative input, which stops the vectorizer)
+    inline void sqrtDefault(double* values, std::size_t count)
+    {
+#ifdef __SSE2__
+        for (std::size_t i = 0; i < count; i += 2)
+            _mm_store_pd(values + i, _mm_sqrt_pd(_mm_load_pd(values + i)));
+#else
+        for (std::size_t i = 0; i < count; i++)
+            values[i] = std::sqrt(values[i]);
+#endif
+    }
+
+#ifdef NOISE_GENERATOR_X86
+    __attribute__((target("avx2"))) inline void sqrtAvx2(double* values, std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; i += 4)
+            _mm256_store_pd(values + i, _mm256_sqrt_pd(_mm256_load_pd(values + i)));
+    }
+#endif
+
+    // Fill the block: xoshiro256++ lanes, then Box-Muller on (u1, u2) with angle 2y, y in [-pi/2, pi/2)
+    // (sin/cos of y by Taylor series, error below 1e-11, then the double-angle formulas).
+    // Inlined into one kernel per instruction set, with the square roots of that instruction set.
+    template <void (*SquareRoots)(double*, std::size_t)>
+    __attribute__((always_inline)) inline void fill(std::array<std::array<std::uint64_t, NoiseGenerator::lanes>, 4>& state,
+                                                    double* block)
+    {
+        // One xoshiro256++ step of the four streams per vector (GCC vector extension: AVX2 or two SSE2 halves)
+        alignas(64) std::uint64_t bits[NoiseGenerator::block_size];
+        Lanes s0, s1, s2, s3;
+        std::memcpy(&s0, state[0].data(), sizeof(Lanes));
+        std::memcpy(&s1, state[1].data(), sizeof(Lanes));
+        std::memcpy(&s2, state[2].data(), sizeof(Lanes));
+        std::memcpy(&s3, state[3].data(), sizeof(Lanes));
+        for (std::size_t i = 0; i < NoiseGenerator::block_size; i += NoiseGenerator::lanes)
+        {
+            const Lanes sum = s0 + s3;
+            const Lanes result = ((sum << 23) | (sum >> 41)) + s0;
+            std::memcpy(&bits[i], &result, sizeof(Lanes));
+            const Lanes t = s1 << 17;
+            s2 ^= s0;
+            s3 ^= s1;
+            s1 ^= s2;
+            s0 ^= s3;
+            s2 ^= t;
+            s3 = (s3 << 45) | (s3 >> 19);
+        }
+        std::memcpy(state[0].data(), &s0, sizeof(Lanes));
+        std::memcpy(state[1].data(), &s1, sizeof(Lanes));
+        std::memcpy(state[2].data(), &s2, sizeof(Lanes));
+        std::memcpy(state[3].data(), &s3, sizeof(Lanes));
+
+        // Radius: sqrt(-2 log u1), u1 in (0, 1]
+        alignas(64) double radius[pairs];
+        for (std::size_t i = 0; i < pairs; i++)
+            radius[i] = -2.0 * logUnit(2.0 - uniform12(bits[i]));
+        SquareRoots(radius, pairs);
+
+        for (std::size_t i = 0; i < pairs; i++)
+        {
+            const double y = 3.141592653589793 * (uniform12(bits[pairs + i]) - 1.5);   // [-pi/2, pi/2)
+
+            const double y2 = y * y;
+            const double sine = y * (1.0 - y2 * (1.0 / 6.0) * (1.0 - y2 * (1.0 / 20.0) * (1.0 - y2 * (1.0 / 42.0) * (1.0 - y2 * (1.0 / 72.0)
+                * (1.0 - y2 * (1.0 / 110.0) * (1.0 - y2 * (1.0 / 156.0) * (1.0 - y2 * (1.0 / 210.0) * (1.0 - y2 * (1.0 / 272.0)))))))));
+            const double cosine = 1.0 - y2 * (1.0 / 2.0) * (1.0 - y2 * (1.0 / 12.0) * (1.0 - y2 * (1.0 / 30.0) * (1.0 - y2 * (1.0 / 56.0)
+                * (1.0 - y2 * (1.0 / 90.0) * (1.0 - y2 * (1.0 / 132.0) * (1.0 - y2 * (1.0 / 182.0) * (1.0 - y2 * (1.0 / 240.0) * (1.0 - y2 * (1.0 / 306.0)))))))));
+
+            block[i] = radius[i] * (cosine * cosine - sine * sine);
+            block[pairs + i] = radius[i] * (2.0 * sine * cosine);
+        }
+    }
+
+    // Baseline kernel
+    void fillDefault(std::array<std::array<std::uint64_t, NoiseGenerator::lanes>, 4>& state, double* block)
+    {
+        fill<sqrtDefault>(state, block);
+    }
+
+#ifdef NOISE_GENERATOR_X86
+    // AVX2 kernel: the four lanes and four values per vector
+    __attribute__((target("avx2")))
+    void fillAvx2(std::array<std::array<std::uint64_t, NoiseGenerator::lanes>, 4>& state, double* block)
+    {
+        fill<sqrtAvx2>(state, block);
+    }
+#endif
+}
+
+// Restart the streams from a seed
+void NoiseGenerator::reseed(std::uint64_t seed)
+{
+    std::uint64_t expander = seed;
+    for (std::size_t lane = 0; lane < lanes; lane++)
+        for (std::size_t word = 0; word < 4; word++)
+            state_[word][lane] = splitMix64(expander);
+    index_ = block_size;
+}
+
+// Seed of a named stream derived from a master seed (FNV-1a of the name, mixed with the master seed)
+std::uint64_t NoiseGenerator::streamSeed(std::uint64_t master_seed, std::string_view name)
+{
+    std::uint64_t hash = 0xCBF29CE484222325ull;
+    for (char character : name)
+    {
+        hash ^= static_cast<unsigned char>(character);
+        hash *= 0x100000001B3ull;
+    }
+    std::uint64_t mixer = master_seed ^ hash;
+    return splitMix64(mixer);
+}
+
+// Generate the next block of normal values
+void NoiseGenerator::refill()
+{
+#ifdef NOISE_GENERATOR_X86
+    static const bool avx2 = __builtin_cpu_supports("avx2");
+    if (avx2)
+        fillAvx2(state_, block_.data());
+    else
+        fillDefault(state_, block_.data());
+#else
+    fillDefault(state_, block_.data());
+#endif
+    index_ = 0;
+}
@@ -0,0 +1,101 @@
+#include "SensorSuite.hpp"
+#include <fstream>
+#include <set>
+#include <sstream>
+
+namespace
+{
+    // Parse a non-negative integer field
+    bool toSize(const std::string& field, std::size_t& value)
+    {
+        if (field.empty() || field.find_first_not_of("0123456789") != std::string::npos)
+            return false;
+        std::istringstream(field) >> value;
+        return true;
+    }
+}
+
+// Read a sensor suite file: one group per line, "<imu|gnss> <name> <count> <frequency> <noise> [depth]",
+// '#' starts a comment. Returns false with a message naming the faulty line on error.
+bool loadSensorGroups(const std::string& path, std::vector<SensorGroup>& groups, std::string& error)
+{
+    std::ifstream file(path);
+    if (!file)
+    {
+        error = "cannot open " + path;
+        return false;
+    }
+
+    std::vector<SensorGroup> loaded;
+    std::string line;
+    for (int number = 1; std::getline(file, line); number++)
+    {
+        line = line.substr(0, line.find('#'));
+        std::istringstream fields(line);
+        std::string kind;
+        if (!(fields >> kind))
+            continue; // Blank or comment line
+
+        SensorGroup group{SensorKind::Imu, "", 0, 0.0, 0.0};
+        std::string count;
+        std::string depth;
+        std::string extra;
+        const bool parsed = static_cast<bool>(fields >> group.name >> count >> group.frequency >> group.noise);
+        fields >> depth >> extra;
+        if (!parsed || !toSize(count, group.count) || (!depth.empty() && !toSize(depth, group.depth)) || !extra.empty())
+        {
+            error = path + ":" + std::to_string(number) + ": expected <imu|gnss> <name> <count> <frequency> <noise> [depth]";
+            return false;
+        }
+        if (kind == "imu")
+            group.kind = SensorKind::Imu;
+        else if (kind == "gnss")
+            group.kind = SensorKind::Gnss;
+        else
+        {
+            error = path + ":" + std::to_string(number) + ": unknown sensor type " + kind;
+            return false;
+        }
+        loaded.push_back(group);
+    }
+
+    if (!validateSensorGroups(loaded, error))
+    {
+        error = path + ": " + error;
+        return false;
+    }
+    groups = std::move(loaded);
+    return true;
+}
+
+// Check that the sensor names are unique and the counts, frequencies and noises valid
+bool validateSensorGroups(const std::vector<SensorGroup>& groups, std::string& error)
+{
+    std::set<std::string> names;
+    for (const SensorGroup& group : groups)
+    {
+        if (group.name.empty() || group.count == 0 || !(group.frequency > 0.0) || !(group.noise >= 0.0))
+        {
+            error = "group " + group.name + ": the count and frequency must be positive and the noise not negative";
+            return false;
+        }
+        for (std::size_t i = 1; i <= group.count; i++)
+        {
+            if (!names.insert(group.name + std::to_string(i)).second)
+            {
+                error = "group " + group.name + ": sensor name " + group.name + std::to_string(i) + " already used";
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Number of sensors of a kind in a suite
+std::size_t countSensors(const std::vector<SensorGroup>& groups, SensorKind kind)
+{
+    std::size_t count = 0;
+    for (const SensorGroup& group : groups)
+        count += group.kind == kind ? group.count : 0;
+    return count;
+}
@@ -0,0 +1,202 @@
+#include "Scenario.hpp"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+namespace
+{
+    // Parse a number field (the whole field)
+    template <typename T>
+    bool toNumber(const std::string& field, T& value)
+    {
+        std::istringstream stream(field);
+        T parsed;
+        if (!(stream >> parsed) || !stream.eof())
+            return false;
+        value = parsed;
+        return true;
+    }
+
+    // Apply one setting (values = the fields after the key)
+    bool applySetting(Scenario& scenario, const std::string& key, const std::vector<std::string>& values, std::string& error)
+    {
+        const std::string value = values.empty() ? "" : values[0];
+        bool valid = values.size() == 1;
+        if (key == "duration")
+            valid = valid && toNumber(value, scenario.duration_s) && scenario.duration_s >= 0.0;
+        else if (key == "seed")
+            valid = valid && toNumber(value, scenario.seed);
+        else if (key == "config")
+            scenario.sensor_config = value;
+        else if (key == "mode")
+        {
+            if (value == "thread")
+                scenario.execution_mode = ExecutionMode::ThreadPerComponent;
+            else if (value == "reactor")
+                scenario.execution_mode = ExecutionMode::Reactor;
+            else if (value == "pool")
+                scenario.execution_mode = ExecutionMode::WorkerPool;
+            else
+                valid = false;
+        }
+        else if (key == "fusion")
+        {
+            if (value == "average")
+                scenario.fusion_engine = FusionEngine::Average;
+            else if (value == "kalman")
+                scenario.fusion_engine = FusionEngine::Kalman;
+            else
+                valid = false;
+        }
+        else if (key == "format")
+        {
+            if (value == "csv")
+                scenario.recording_format = RecordingFormat::Csv;
+            else if (value == "binary")
+                scenario.recording_format = RecordingFormat::Binary;
+            else
+                valid = false;
+        }
+        else if (key == "data")
+            scenario.data_directory = value;
+        else if (key == "log")
+            scenario.log_directory = value;
+        else if (key == "console")
+        {
+            valid = valid && (value == "on" || value == "off");
+            scenario.console = value == "on";
+        }
+        else if (key == "metrics")
+            scenario.metrics_file = value == "off" ? "" : value;
+        else if (key == "shm")
+        {
+            valid = valid && value.find('/') == std::string::npos;
+            scenario.shared_memory = value == "off" ? "" : value;
+        }
+        else if (key == "fault")
+        {
+            FaultEvent fault{0.0, -1.0, values.size() == 3 ? values[2] : ""};
+            valid = values.size() == 3 && toNumber(values[0], fault.start_s) && fault.start_s >= 0.0 &&
+                    (values[1] == "end" || (toNumber(values[1], fault.end_s) && fault.end_s >= fault.start_s));
+            if (valid)
+                scenario.faults.push_back(fault);
+        }
+        else
+        {
+            error = "unknown setting " + key;
+            return false;
+        }
+
+        if (!valid || (!values.empty() && values[0].empty()))
+        {
+            error = "invalid value for " + key;
+            return false;
+        }
+        return true;
+    }
+}
+
+// Read a scenario file: one setting per line, "<key> <value...>", '#' starts a comment
+bool loadScenario(const std::string& path, Scenario& scenario, std::string& error)
+{
+    std::ifstream file(path);
+    if (!file)
+    {
+        error = "cannot open " + path;
+        return false;
+    }
+
+    std::string line;
+    for (int number = 1; std::getline(file, line); number++)
+    {
+        std::istringstream fields(line.substr(0, line.find('#')));
+        std::string key;
+        if (!(fields >> key))
+            continue; // Blank or comment line
+
+        std::vector<std::string> values;
+        for (std::string value; fields >> value;)
+            values.push_back(value);
+        if (!applySetting(scenario, key, values, error))
+        {
+            error = path + ":" + std::to_string(number) + ": " + error;
+            return false;
+        }
+    }
+    return true;
+}
+
+// Apply the command line: "--<key> <value>" for every scenario key, "--scenario <file>" loads a file
+bool parseScenarioArguments(int argc, char** argv, Scenario& scenario, std::string& error)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string argument = argv[i];
+        if (argument.compare(0, 2, "--") != 0 || i + 1 >= argc)
+        {
+            error = "expected --<setting> <value> at " + argument;
+            return false;
+        }
+        const std::string key = argument.substr(2);
+        const std::string value = argv[++i];
+        if (key == "scenario")
+        {
+            if (!loadScenario(value, scenario, error))
+                return false;
+            continue;
+        }
+
+        // A fault is one argument, start:end:target
+        std::vector<std::string> values{value};
+        if (key == "fault")
+        {
+            values.clear();
+            std::istringstream fields(value);
+            for (std::string field; std::getline(fields, field, ':');)
+                values.push_back(field);
+        }
+        if (!applySetting(scenario, key, values, error))
+            return false;
+    }
+    return true;
+}
+
+// Run the scenario: start the simulation, play the fault timeline, stop after the duration
+void runScenario(Simulator& simulator, const Scenario& scenario)
+{
+    using namespace std::chrono;
+
+    // Timeline of injections and clearances; the faults still active at the end are cleared before the stop
+    struct Step
+    {
+        double at_s;
+        bool enable;
+        std::string target;
+    };
+    std::vector<Step> steps;
+    for (const FaultEvent& fault : scenario.faults)
+    {
+        if (fault.start_s >= scenario.duration_s)
+            continue;
+        steps.push_back({fault.start_s, true, fault.target});
+        steps.push_back({fault.end_s < 0.0 ? scenario.duration_s : std::min(fault.end_s, scenario.duration_s), false, fault.target});
+    }
+    std::stable_sort(steps.begin(), steps.end(), [](const Step& a, const Step& b) { return a.at_s < b.at_s; });
+
+    Logger::log(Logger::Level::Info, "[Scenario] Running for " + std::to_string(scenario.duration_s) + " s with " +
+        std::to_string(scenario.faults.size()) + " faults");
+    simulator.start();
+    auto at = [start = steady_clock::now()](double seconds) {
+        return start + duration_cast<steady_clock::duration>(duration<double>(seconds));
+    };
+    for (const Step& step : steps)
+    {
+        std::this_thread::sleep_until(at(step.at_s));
+        Logger::log(Logger::Level::Info, "[Scenario] " + std::string(step.enable ? "Injecting" : "Clearing") + " fault on " + step.target);
+        simulator.injectFault(step.target, step.enable);
+    }
+    std::this_thread::sleep_until(at(scenario.duration_s));
+    simulator.stop();
+}
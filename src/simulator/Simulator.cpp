@@ -1,4 +1,6 @@
 #include "Simulator.hpp"
+#include <algorithm>
+#include <cstdio>
 #include <iostream>
 
 Simulator::Simulator(
@@ -12,6 +14,50 @@ Simulator::Simulator(
       fdir_(fdir), 
       running_(false) 
 {
+    // Bus topics: the sensor buffers, the processing unit outputs and the FDIR alarms
+    for (const auto& imu_sensor : imu_sensors_)
+        bus_.add(imu_sensor->getTopic());
+    for (const auto& gnss_sensor : gnss_sensors_)
+        bus_.add(gnss_sensor->getTopic());
+    bus_.add(processing_unit_->getOutputTopic());
+    bus_.add(fdir_->getAlarmTopic());
+
+    // Runtime metrics: sensors (buffer occupancy), processing unit (recorder queue), FDIR, logger queue
+    auto addSensor = [this](const std::shared_ptr<Sensor>& sensor, const std::string& kind) {
+        const Sensor* raw = sensor.get();
+        metrics_.add({raw->getName(), kind, &raw->getMetrics(), "",
+            [raw] { return raw->getTimingStats(); },
+            [raw] { return std::make_pair(static_cast<std::size_t>(raw->getSampleHead() - raw->getSampleTail()), raw->getBufferCapacity()); },
+            nullptr});
+    };
+    for (const auto& imu_sensor : imu_sensors_)
+        addSensor(imu_sensor, "imu");
+    for (const auto& gnss_sensor : gnss_sensors_)
+        addSensor(gnss_sensor, "gnss");
+
+    const ProcessingUnit* processing_unit_raw = processing_unit_.get();
+    metrics_.add({"processing_unit", "processing", &processing_unit_raw->getMetrics(), "output_mutex",
+        [processing_unit_raw] { return processing_unit_raw->getTimingStats(); },
+        [processing_unit_raw] { return std::make_pair(processing_unit_raw->getRecorder().queueDepth(), processing_unit_raw->getRecorder().queueCapacity()); },
+        [processing_unit_raw] { return processing_unit_raw->getRecorder().droppedCount(); }});
+
+    const Fdir* fdir_raw = fdir_.get();
+    metrics_.add({"fdir", "fdir", &fdir_raw->getMetrics(), "fdir_mutex",
+        [fdir_raw] { return fdir_raw->getTimingStats(); },
+        nullptr,
+        nullptr});
+
+    metrics_.add({"logger", "logger", nullptr, "", nullptr,
+        [] { return std::make_pair(Logger::queueDepth(), Logger::queueCapacity()); },
+        [] { return Logger::droppedCount(); }});
+    metrics_.addFamilies([this] { return bus_.prometheus(); });
+}
+
+// Write the metrics snapshot to a file every interval while the simulation runs (set before start(), "" = off)
+void Simulator::setMetricsExport(const std::string& path, std::chrono::milliseconds interval)
+{
+    metrics_path_ = path;
+    metrics_interval_ = interval;
 }
 
 void Simulator::start() 
@@ -25,7 +71,12 @@ void Simulator::start()
     }
     
     running_ = true;
-    simulation_thread_ = std::thread(&Simulator::run, this);
+    started_at_ = std::chrono::steady_clock::now();
+    startComponents();
+
+    // Periodic metrics snapshot for a local scraper
+    if (!metrics_path_.empty())
+        metrics_.startExport(metrics_path_, metrics_interval_);
 }
 
 void Simulator::stop() 
@@ -40,9 +91,7 @@ void Simulator::stop()
     }
     
     running_ = false;
-    //if (simulation_thread_.joinable())
-    //    simulation_thread_.join(); // Wait for the thread to finish
-    
+
     // Stop all sensors 
     for (const auto& imu_sensor : imu_sensors_) {
         if (imu_sensor->isRunning()) 
@@ -59,10 +108,11 @@ void Simulator::stop()
     // Stop the processing unit and FDIR
     processing_unit_->stop();
     fdir_->stop();
+    logLatencies();
 
-    // Wait for thread to finish
-    if (simulation_thread_.joinable())
-        simulation_thread_.join();
+    // Last metrics snapshot of the run
+    metrics_.stopExport();
+    stopped_at_ = std::chrono::steady_clock::now();
 }
 
 // Inject faults into IMU sensors
@@ -96,18 +146,128 @@ void Simulator::injectGnssFaults(bool enable)
     }
 }
 
-void Simulator::run() 
+// Fault injection by target: "imu", "gnss" or a sensor name. Returns false if no sensor matches.
+bool Simulator::injectFault(const std::string& target, bool enable)
 {
-    std::lock_guard<std::mutex> lock(simulation_mutex_);
+    if (target == "imu")
+    {
+        injectImuFaults(enable);
 
+        // A cleared fault brings the IMUs stopped by it back online while the simulation runs
+        if (!enable && running_)
+        {
+            for (const auto& imu_sensor : imu_sensors_)
+                if (!imu_sensor->isRunning())
+                    imu_sensor->start();
+        }
+    }
+    else if (target == "gnss")
+        injectGnssFaults(enable);
+    else
+    {
+        std::shared_ptr<Sensor> sensor;
+        for (const auto& imu_sensor : imu_sensors_)
+            if (imu_sensor->getName() == target)
+                sensor = imu_sensor;
+        for (const auto& gnss_sensor : gnss_sensors_)
+            if (gnss_sensor->getName() == target)
+                sensor = gnss_sensor;
+        if (!sensor)
+        {
+            Logger::log(Logger::Level::Warning, "[Simulator] No sensor named " + target + " to inject a fault into");
+            return false;
+        }
+        sensor->injectFault(enable);
+    }
+    return true;
+}
+
+// Summary of the last run (or of the running one): throughput, drops, latencies and FDIR detections
+std::string Simulator::summary() const
+{
+    const auto end = running_ ? std::chrono::steady_clock::now() : stopped_at_;
+    const double seconds = std::max(1e-9, std::chrono::duration<double>(end - started_at_).count());
+    char line[256];
+    std::string text;
+
+    std::snprintf(line, sizeof(line), "Duration: %.2f s\n", seconds);
+    text += line;
+
+    // Sensor throughput per kind
+    auto addSensors = [&](const char* kind, const auto& sensors) {
+        std::uint64_t produced = 0;
+        std::uint64_t dropped = 0;
+        for (const auto& sensor : sensors)
+        {
+            const ComponentMetrics::Snapshot counters = sensor->getMetrics().snapshot();
+            produced += counters.produced;
+            dropped += counters.dropped;
+        }
+        std::snprintf(line, sizeof(line), "%s: %zu sensors, %llu samples (%.1f/s), %llu dropped\n", kind, sensors.size(),
+            static_cast<unsigned long long>(produced), static_cast<double>(produced) / seconds, static_cast<unsigned long long>(dropped));
+        text += line;
+    };
+    addSensors("IMU", imu_sensors_);
+    addSensors("GNSS", gnss_sensors_);
+
+    const ComponentMetrics::Snapshot processing = processing_unit_->getMetrics().snapshot();
+    std::snprintf(line, sizeof(line), "Processing unit: %llu outputs (%.1f/s), %llu not recorded, data in %s\n",
+        static_cast<unsigned long long>(processing.produced), static_cast<double>(processing.produced) / seconds,
+        static_cast<unsigned long long>(processing_unit_->getRecorder().droppedCount()), processing_unit_->getDataDirectory().c_str());
+    text += line;
+
+    // Latency percentiles
+    std::vector<const LatencyTracker*> trackers = processing_unit_->getLatencyTrackers();
+    for (const LatencyTracker* tracker : fdir_->getLatencyTrackers())
+        trackers.push_back(tracker);
+    for (const LatencyTracker* tracker : trackers)
+        text += "Latency " + tracker->getName() + ": " + tracker->summary().format() + "\n";
+
+    // FDIR detections
+    const FdirDetections detections = fdir_->getDetections();
+    std::snprintf(line, sizeof(line), "FDIR: %llu samples checked; %llu silent, %llu recovered, %llu stuck, %llu noise, %llu bias, %llu outvoted, %llu invalid outputs\n",
+        static_cast<unsigned long long>(fdir_->getMetrics().snapshot().produced),
+        static_cast<unsigned long long>(detections.silent), static_cast<unsigned long long>(detections.recovered),
+        static_cast<unsigned long long>(detections.stuck), static_cast<unsigned long long>(detections.noise),
+        static_cast<unsigned long long>(detections.bias), static_cast<unsigned long long>(detections.outvoted),
+        static_cast<unsigned long long>(detections.invalid_output));
+    text += line;
+
+    // Bus subscribers that fell behind their topic
+    for (const SubscriberStats& stats : bus_.getSubscribers())
+    {
+        if (stats.missed == 0)
+            continue;
+        std::snprintf(line, sizeof(line), "Bus: subscriber %s of %s missed %llu messages\n", stats.subscriber.c_str(),
+            stats.topic.c_str(), static_cast<unsigned long long>(stats.missed));
+        text += line;
+    }
+    return text;
+}
+
+// Log the latency percentiles of the processing unit and FDIR since the last start
+void Simulator::logLatencies() const
+{
+    std::vector<const LatencyTracker*> trackers = processing_unit_->getLatencyTrackers();
+    for (const LatencyTracker* tracker : fdir_->getLatencyTrackers())
+        trackers.push_back(tracker);
+    for (const LatencyTracker* tracker : trackers)
+        Logger::log(Logger::Level::Info, "[Simulator] Latency " + tracker->getName() + ": " + tracker->summary().format());
+}
+
+// Start every component (lock held)
+void Simulator::startComponents() 
+{
     // Simulate sensor data generation
     Logger::log(Logger::Level::Info, "[Simulator] Starting IMU sensors");
     for (const auto& imu_sensor : imu_sensors_) { // IMU
+        imu_sensor->resetMetrics();
         imu_sensor->start();
     }
 
     Logger::log(Logger::Level::Info, "[Simulator] Starting GNSS sensors");
     for (const auto& gnss_sensor : gnss_sensors_) { // GNSS
+        gnss_sensor->resetMetrics();
         gnss_sensor->start();
     }
 
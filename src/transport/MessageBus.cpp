@@ -0,0 +1,133 @@
+#include "MessageBus.hpp"
+#include <cstdio>
+
+// Count the messages overwritten before a poll, warning once when the subscriber falls behind
+void SubscriptionBase::reportMissed(const std::string& topic, std::uint64_t missed)
+{
+    if (missed == 0)
+    {
+        lagging_ = false;
+        return;
+    }
+
+    // Single writer: a plain store is enough
+    missed_.store(missed_.load(std::memory_order_relaxed) + missed, std::memory_order_relaxed);
+    if (!lagging_)
+        Logger::log(Logger::Level::Warning, "[MessageBus] Subscriber " + subscriber_ + " of topic " + topic +
+            " is too slow: " + std::to_string(missed) + " messages overwritten before being read");
+    lagging_ = true;
+}
+
+// State of the live subscribers
+std::vector<SubscriberStats> TopicBase::getSubscribers() const
+{
+    const std::uint64_t published = getPublished();
+    std::vector<SubscriberStats> stats;
+    std::lock_guard<std::mutex> lock(subscribers_mutex_);
+    for (const auto& weak : subscribers_)
+    {
+        if (auto subscription = weak.lock())
+        {
+            const std::uint64_t cursor = subscription->getCursor();
+            stats.push_back({name_, subscription->getSubscriber(), published > cursor ? published - cursor : 0, subscription->getMissed()});
+        }
+    }
+    return stats;
+}
+
+// Track a new subscriber, forgetting the ones released
+void TopicBase::attach(const std::shared_ptr<const SubscriptionBase>& subscription) const
+{
+    std::lock_guard<std::mutex> lock(subscribers_mutex_);
+    subscribers_.erase(std::remove_if(subscribers_.begin(), subscribers_.end(),
+        [](const std::weak_ptr<const SubscriptionBase>& weak) { return weak.expired(); }), subscribers_.end());
+    subscribers_.push_back(subscription);
+}
+
+// Register a topic under its name (false if the name is taken)
+bool MessageBus::add(std::shared_ptr<TopicBase> topic)
+{
+    const std::string name = topic->getName();
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!topics_.emplace(name, std::move(topic)).second)
+    {
+        Logger::log(Logger::Level::Error, "[MessageBus] Topic " + name + " is already registered");
+        return false;
+    }
+    return true;
+}
+
+// Names of the registered topics
+std::vector<std::string> MessageBus::getTopics() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<std::string> names;
+    for (const auto& [name, topic] : topics_)
+        names.push_back(name);
+    return names;
+}
+
+// State of the subscribers of every topic
+std::vector<SubscriberStats> MessageBus::getSubscribers() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<SubscriberStats> stats;
+    for (const auto& [name, topic] : topics_)
+    {
+        std::vector<SubscriberStats> subscribers = topic->getSubscribers();
+        stats.insert(stats.end(), subscribers.begin(), subscribers.end());
+    }
+    return stats;
+}
+
+// Topic and subscriber metrics in the Prometheus text format
+std::string MessageBus::prometheus() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::string text;
+    char line[256];
+
+    text += "# HELP sensors_bus_messages_published_total Messages published on the topic\n";
+    text += "# TYPE sensors_bus_messages_published_total counter\n";
+    for (const auto& [name, topic] : topics_)
+    {
+        std::snprintf(line, sizeof(line), "sensors_bus_messages_published_total{topic=\"%s\"} %llu\n",
+            name.c_str(), static_cast<unsigned long long>(topic->getPublished()));
+        text += line;
+    }
+
+    text += "# HELP sensors_bus_topic_capacity Preallocated message slots of the topic\n";
+    text += "# TYPE sensors_bus_topic_capacity gauge\n";
+    for (const auto& [name, topic] : topics_)
+    {
+        std::snprintf(line, sizeof(line), "sensors_bus_topic_capacity{topic=\"%s\"} %zu\n", name.c_str(), topic->getCapacity());
+        text += line;
+    }
+
+    // Subscribers: unread messages (a lag above the capacity means messages will be lost) and losses
+    std::vector<SubscriberStats> subscribers;
+    for (const auto& [name, topic] : topics_)
+    {
+        std::vector<SubscriberStats> stats = topic->getSubscribers();
+        subscribers.insert(subscribers.end(), stats.begin(), stats.end());
+    }
+    if (subscribers.empty())
+        return text;
+    text += "# HELP sensors_bus_subscriber_lag Messages published but not read yet by the subscriber\n";
+    text += "# TYPE sensors_bus_subscriber_lag gauge\n";
+    for (const SubscriberStats& stats : subscribers)
+    {
+        std::snprintf(line, sizeof(line), "sensors_bus_subscriber_lag{topic=\"%s\",subscriber=\"%s\"} %llu\n",
+            stats.topic.c_str(), stats.subscriber.c_str(), static_cast<unsigned long long>(stats.lag));
+        text += line;
+    }
+    text += "# HELP sensors_bus_subscriber_missed_total Messages overwritten before the subscriber read them\n";
+    text += "# TYPE sensors_bus_subscriber_missed_total counter\n";
+    for (const SubscriberStats& stats : subscribers)
+    {
+        std::snprintf(line, sizeof(line), "sensors_bus_subscriber_missed_total{topic=\"%s\",subscriber=\"%s\"} %llu\n",
+            stats.topic.c_str(), stats.subscriber.c_str(), static_cast<unsigned long long>(stats.missed));
+        text += line;
+    }
+    return text;
+}
@@ -0,0 +1,157 @@
+#include "ShmRing.hpp"
+#include <cstring>
+#include <new>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+    // Smallest power of two not below a capacity
+    std::uint64_t roundCapacity(std::size_t capacity)
+    {
+        std::uint64_t rounded = 1;
+        while (rounded < capacity)
+            rounded <<= 1;
+        return rounded;
+    }
+
+    // Copy a string into a fixed NUL-terminated field
+    template <std::size_t N>
+    void copyField(char (&field)[N], const std::string& text)
+    {
+        std::strncpy(field, text.c_str(), N - 1);
+        field[N - 1] = '\0';
+    }
+}
+
+// Constructor: create the region "/<name>" with at least capacity slots
+ShmRingWriter::ShmRingWriter(const std::string& name, const std::string& sensor, const std::string& kind,
+                             std::size_t capacity, double frequency)
+    : name_(name)
+{
+    const std::uint64_t slots = roundCapacity(capacity);
+    const std::string path = "/" + name_;
+
+    // Replace the region of a previous run: readers still attached to it keep the old one
+    ::shm_unlink(path.c_str());
+    int fd = ::shm_open(path.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0)
+        return;
+
+    const std::size_t size = sizeof(ShmRingHeader) + slots * sizeof(ShmSlot);
+    void* mapping = MAP_FAILED;
+    if (::ftruncate(fd, static_cast<off_t>(size)) == 0)
+        mapping = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED)
+    {
+        ::shm_unlink(path.c_str());
+        return;
+    }
+
+    // The region is zero-filled: describe it, then publish the magic last
+    ShmRingHeader* header = new (mapping) ShmRingHeader();
+    ShmSlot* slot_array = reinterpret_cast<ShmSlot*>(static_cast<char*>(mapping) + sizeof(ShmRingHeader));
+    for (std::uint64_t i = 0; i < slots; i++)
+        new (&slot_array[i]) ShmSlot();
+    header->version = ShmRingHeader::current_version;
+    header->header_size = sizeof(ShmRingHeader);
+    header->slot_size = sizeof(ShmSlot);
+    header->capacity = slots;
+    header->writer_pid = static_cast<std::uint32_t>(::getpid());
+    header->frequency = frequency;
+    copyField(header->kind, kind);
+    copyField(header->sensor, sensor);
+    header->magic.store(ShmRingHeader::magic_value, std::memory_order_release);
+
+    mapping_ = mapping;
+    size_ = size;
+    header_ = header;
+    slots_ = slot_array;
+    mask_ = slots - 1;
+}
+
+// Destructor: unmap and unlink the region
+ShmRingWriter::~ShmRingWriter()
+{
+    if (!mapping_)
+        return;
+    ::munmap(mapping_, size_);
+    ::shm_unlink(("/" + name_).c_str());
+}
+
+// Constructor: map the region "/<name>" read-only
+ShmRingReader::ShmRingReader(const std::string& name) : name_(name)
+{
+    int fd = ::shm_open(("/" + name_).c_str(), O_RDONLY, 0);
+    if (fd < 0)
+        return;
+
+    struct stat info;
+    void* mapping = MAP_FAILED;
+    if (::fstat(fd, &info) == 0 && static_cast<std::size_t>(info.st_size) >= sizeof(ShmRingHeader))
+        mapping = ::mmap(nullptr, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED)
+        return;
+
+    // Check the layout before trusting any size in it
+    const std::size_t size = static_cast<std::size_t>(info.st_size);
+    const ShmRingHeader* header = static_cast<const ShmRingHeader*>(mapping);
+    const std::uint64_t slots = header->capacity;
+    const bool valid = header->magic.load(std::memory_order_acquire) == ShmRingHeader::magic_value &&
+        header->version == ShmRingHeader::current_version && header->header_size == sizeof(ShmRingHeader) &&
+        header->slot_size == sizeof(ShmSlot) && slots > 0 && (slots & (slots - 1)) == 0 &&
+        slots <= (size - sizeof(ShmRingHeader)) / sizeof(ShmSlot);
+    if (!valid)
+    {
+        ::munmap(mapping, size);
+        return;
+    }
+
+    mapping_ = mapping;
+    size_ = size;
+    header_ = header;
+    slots_ = reinterpret_cast<const ShmSlot*>(static_cast<const char*>(mapping) + sizeof(ShmRingHeader));
+    mask_ = slots - 1;
+}
+
+// Destructor: unmap the region
+ShmRingReader::~ShmRingReader()
+{
+    if (mapping_)
+        ::munmap(const_cast<void*>(mapping_), size_);
+}
+
+// Copy out one sample; false if it is not readable
+bool ShmRingReader::read(std::uint64_t index, Sample& sample) const
+{
+    if (index < tail() || index >= head())
+        return false;
+
+    const ShmSlot& slot = slots_[index & mask_];
+    if (slot.sequence.load(std::memory_order_acquire) != 2 * index + 2)
+        return false;
+    sample.index = index;
+    sample.timestamp_ns = slot.timestamp_ns;
+    sample.values = slot.values;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return slot.sequence.load(std::memory_order_relaxed) == 2 * index + 2;
+}
+
+// Copy out the latest sample, if any
+std::optional<ShmRingReader::Sample> ShmRingReader::latest() const
+{
+    while (true)
+    {
+        const std::uint64_t head = this->head();
+        if (head == tail())
+            return std::nullopt;
+
+        Sample sample;
+        if (read(head - 1, sample))
+            return sample;
+    }
+}
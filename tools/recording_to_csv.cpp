@@ -0,0 +1,67 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <cstring>
+#include "BinaryRecorder.hpp"
+
+// Convert a binary recording (imu.bin / gnss.bin) back to the CSV layout
+// written by the ProcessingUnit (timestamp in ms, values, validity flag)
+int main(int argc, char* argv[])
+{
+    if (argc < 2 || argc > 3)
+    {
+        std::cerr << "Usage: " << argv[0] << " <recording.bin> [output.csv]" << std::endl;
+        return 1;
+    }
+
+    RecordingReader reader(argv[1]);
+    if (!reader.isOpen())
+    {
+        std::cerr << "Cannot read recording: " << argv[1] << std::endl;
+        return 1;
+    }
+
+    // Write to the given file or to the standard output
+    std::ofstream file;
+    if (argc == 3)
+    {
+        file.open(argv[2]);
+        if (!file.is_open())
+        {
+            std::cerr << "Cannot open output file: " << argv[2] << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& out = argc == 3 ? file : std::cout;
+
+    // Header line from the schema (names bounded by their field, NUL or not)
+    const recording::FileHeader& header = reader.header();
+    for (std::size_t column = 0; column < header.column_count; column++)
+    {
+        const char* name = header.columns[column].name;
+        out << (column > 0 ? "," : "") << std::string_view(name, strnlen(name, recording::name_length));
+    }
+    out << "\n";
+
+    // Rows, chunk by chunk, read in place from the mapping
+    for (std::size_t chunk = 0; chunk < reader.chunkCount(); chunk++)
+    {
+        const std::int64_t* timestamps = reader.timestamps(chunk);
+        const double* values_0 = reader.values(chunk, 0);
+        const double* values_1 = reader.values(chunk, 1);
+        const double* values_2 = reader.values(chunk, 2);
+        const std::uint8_t* valid = reader.valid(chunk);
+
+        for (std::uint32_t row = 0; row < reader.rowCount(chunk); row++)
+        {
+            out << timestamps[row] / 1000000 << ","
+                << values_0[row] << ","
+                << values_1[row] << ","
+                << values_2[row] << ","
+                << static_cast<int>(valid[row]) << "\n";
+        }
+    }
+
+    return 0;
+}
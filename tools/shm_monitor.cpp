@@ -0,0 +1,106 @@
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "ShmRing.hpp"
+
+// Attach read-only to the shared memory rings of a running simulation (another process) and
+// print, every interval, the measured rate, the age of the latest sample and the mean of the new
+// samples, read in place from the mapping. A name ending with '*' selects every ring with that prefix.
+int main(int argc, char* argv[])
+{
+    int interval_ms = 1000;
+    int count = 0; // 0 = until interrupted
+    std::vector<std::string> patterns;
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string argument = argv[i];
+        if (argument == "--interval" && i + 1 < argc)
+            interval_ms = std::atoi(argv[++i]);
+        else if (argument == "--count" && i + 1 < argc)
+            count = std::atoi(argv[++i]);
+        else
+            patterns.push_back(argument);
+    }
+    if (patterns.empty() || interval_ms <= 0)
+    {
+        std::cerr << "Usage: " << argv[0] << " [--interval <ms>] [--count <n>] <ring name | prefix*>..." << std::endl;
+        return 1;
+    }
+
+    // Ring names, with the prefixes expanded from the shared memory directory
+    std::vector<std::string> names;
+    for (const std::string& pattern : patterns)
+    {
+        if (pattern.empty() || pattern.back() != '*')
+        {
+            names.push_back(pattern);
+            continue;
+        }
+        const std::string prefix = pattern.substr(0, pattern.size() - 1);
+        std::error_code error;
+        for (const auto& entry : std::filesystem::directory_iterator("/dev/shm", error))
+        {
+            const std::string name = entry.path().filename().string();
+            if (name.compare(0, prefix.size(), prefix) == 0)
+                names.push_back(name);
+        }
+    }
+
+    std::vector<std::unique_ptr<ShmRingReader>> rings;
+    std::vector<std::uint64_t> cursors;
+    for (const std::string& name : names)
+    {
+        auto ring = std::make_unique<ShmRingReader>(name);
+        if (!ring->isOpen())
+        {
+            std::cerr << "Cannot attach to shared memory ring: /" << name << std::endl;
+            continue;
+        }
+        std::cout << "Attached /" << name << ": " << ring->getKind() << " sensor " << ring->getSensor() << ", "
+                  << ring->capacity() << " slots, " << ring->getFrequency() << " Hz" << std::endl;
+        cursors.push_back(ring->head());
+        rings.push_back(std::move(ring));
+    }
+    if (rings.empty())
+        return 1;
+
+    std::cout << std::fixed << std::setprecision(3);
+    for (int round = 0; count == 0 || round < count; round++)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(interval_ms));
+        const std::int64_t now_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+        for (std::size_t i = 0; i < rings.size(); i++)
+        {
+            const ShmRingReader& ring = *rings[i];
+
+            // New samples since the last round, copied out; the ones overwritten or withdrawn meanwhile are skipped
+            const std::uint64_t skipped = ring.tail() > cursors[i] ? ring.tail() - cursors[i] : 0;
+            std::uint64_t seen = 0;
+            std::array<double, 3> sum{};
+            const std::uint64_t head = ring.forEachSince(cursors[i], [&](std::uint64_t, const ShmRingReader::Sample& sample) {
+                for (std::size_t axis = 0; axis < 3; axis++)
+                    sum[axis] += sample.values[axis];
+                seen++;
+            });
+            cursors[i] = head;
+
+            std::cout << std::setw(20) << std::left << ring.getSensor() << std::right
+                      << " rate " << std::setw(9) << static_cast<double>(seen) * 1000.0 / interval_ms << " Hz";
+            if (auto latest = ring.latest())
+                std::cout << "  age " << std::setw(9) << static_cast<double>(now_ns - latest->timestamp_ns) / 1e6 << " ms";
+            else
+                std::cout << "  no sample";
+            if (seen > 0)
+                std::cout << "  mean [" << sum[0] / seen << ", " << sum[1] / seen << ", " << sum[2] / seen << "]";
+            std::cout << "  skipped " << skipped << std::endl;
+        }
+    }
+    return 0;
+}